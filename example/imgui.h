@@ -3518,6 +3518,8 @@ struct ImFontAtlas
     int                         TexGlyphPadding;    // FIXME: Should be called "TexPackPadding". Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    void                        (*BuilderParallelFor)(int job_count, void (*job)(int job_index, void* job_data), void* job_data, void* user_data); // Optional: with the stb_truetype builder, glyphs are rasterized as job_count independent jobs handed to this. Run job(job_index, job_data) for every job_index in [0, job_count), on any threads, and only return once all of them have finished.
+    void*                       BuilderParallelForUserData; // Passed back to BuilderParallelFor.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -134,8 +134,9 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Allocations with a non-NULL user pointer come from ImFontAtlas::BuilderParallelFor jobs and go straight to the C heap: IM_ALLOC() also records debug stats in the current context, which isn't thread-safe.
+#define STBTT_malloc(x,u)   ((u) ? malloc(x) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? free(x) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -2852,6 +2853,53 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// A batch of glyphs from one source font, rasterized into their already packed rectangles
+struct ImFontBuildRasterJob
+{
+    int                 SrcIndex;           // Index into src_tmp_array[]
+    int                 GlyphsBegin;        // First glyph of the batch in GlyphsList[], Rects[] and PackedChars[]
+    int                 GlyphsCount;
+};
+
+struct ImFontBuildRasterJobsData
+{
+    ImFontAtlas*                Atlas;
+    ImFontBuildSrcData*         SrcTmp;
+    const stbtt_pack_context*   PackContext;
+    const ImFontBuildRasterJob* Jobs;
+    bool                        Parallel;   // Running on ImFontAtlas::BuilderParallelFor, so possibly off the calling thread
+};
+
+static void ImFontAtlasBuildRasterJob(int job_index, void* job_data)
+{
+    ImFontBuildRasterJobsData* data = (ImFontBuildRasterJobsData*)job_data;
+    const ImFontBuildRasterJob& job = data->Jobs[job_index];
+    ImFontBuildSrcData& src_tmp = data->SrcTmp[job.SrcIndex];
+    ImFontConfig& cfg = data->Atlas->ConfigData[job.SrcIndex];
+
+    // Work on copies: stbtt_PackFontRangesRenderIntoRects() temporarily writes to the context, and the font's user pointer selects the allocator (see STBTT_malloc)
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    font_info.userdata = data->Parallel ? (void*)data : NULL;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints = src_tmp.GlyphsList.Data + job.GlyphsBegin;
+    pack_range.num_chars = job.GlyphsCount;
+    pack_range.chardata_for_range = src_tmp.PackedChars + job.GlyphsBegin;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphsBegin;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, data->Atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, data->Atlas->TexWidth * 1);
+    }
+}
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -3060,27 +3108,35 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Packed rectangles don't overlap, so with a BuilderParallelFor the glyphs are split into batches that can be rasterized concurrently. Otherwise each source font is a single batch.
+    const int GLYPHS_PER_PARALLEL_JOB = 64;
+    ImVector<ImFontBuildRasterJob> raster_jobs;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        const int glyphs_per_job = atlas->BuilderParallelFor ? GLYPHS_PER_PARALLEL_JOB : src_tmp.GlyphsCount;
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i += glyphs_per_job)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRasterJob job;
+            job.SrcIndex = src_i;
+            job.GlyphsBegin = glyph_i;
+            job.GlyphsCount = ImMin(glyphs_per_job, src_tmp.GlyphsCount - glyph_i);
+            raster_jobs.push_back(job);
         }
-        src_tmp.Rects = NULL;
     }
+    ImFontBuildRasterJobsData raster_jobs_data;
+    raster_jobs_data.Atlas = atlas;
+    raster_jobs_data.SrcTmp = src_tmp_array.Data;
+    raster_jobs_data.PackContext = &spc;
+    raster_jobs_data.Jobs = raster_jobs.Data;
+    raster_jobs_data.Parallel = atlas->BuilderParallelFor != NULL;
+    if (raster_jobs_data.Parallel)
+        atlas->BuilderParallelFor(raster_jobs.Size, ImFontAtlasBuildRasterJob, &raster_jobs_data, atlas->BuilderParallelForUserData);
+    else
+        for (int job_i = 0; job_i < raster_jobs.Size; job_i++)
+            ImFontAtlasBuildRasterJob(job_i, &raster_jobs_data);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
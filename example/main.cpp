@@ -1,4 +1,7 @@
 #include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
 #define SDL_MAIN_HANDLED
 #ifdef __linux
 #define SLAG_X11_BACKEND
@@ -65,7 +68,18 @@ void debugPrint(std::string& message,slag::SlagInitDetails::DebugLevel debugLeve
 {
     std::cout <<message<<std::endl;
 }
-int main()
+//the font file given on the command line, if any, is added as a lazy font whose CJK glyphs are only rasterized once they're drawn
+std::vector<char> loadFontFile(int argc, char** argv)
+{
+    std::vector<char> data;
+    if(argc > 1)
+    {
+        std::ifstream file(argv[1],std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file),std::istreambuf_iterator<char>());
+    }
+    return data;
+}
+int main(int argc, char** argv)
 {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER) != 0)
     {
@@ -110,12 +124,20 @@ int main()
 
     auto sampler = slag::SamplerBuilder().newSampler();
 
+    ImFont* lazyFont = nullptr;
+    std::vector<char> fontData = loadFontFile(argc,argv);
+    if(!fontData.empty())
+    {
+        lazyFont = ImGui_ImplSlag_AddLazyFont(fontData.data(),fontData.size(),18.0f,io.Fonts->GetGlyphRangesChineseFull());
+    }
+
     ImGui_ImplSDL2_InitForOther(window);
     ImGui_ImplSlag_Init(swapchain,pd,extractNativeWindowHandle,sampler,BACK_BUFFER_FORMAT);
 
     bool keepWindowOpen = true;
     while(keepWindowOpen)
     {
+        IMGUI_IMPL_SLAG_TRACE_SCOPE("frame");
         SDL_Event e;
         int width, height;
         while(SDL_PollEvent(&e))
@@ -145,7 +167,12 @@ int main()
 
         }
 
-        if(auto frame = swapchain->next())
+        slag::Frame* frame;
+        {
+            IMGUI_IMPL_SLAG_TRACE_SCOPE("swapchain next");
+            frame = swapchain->next();
+        }
+        if(frame)
         {
             auto frameResources = static_cast<DefaultFrameResources*>(frame->resources);
             auto commandBuffer = frameResources->commandBuffer;
@@ -158,7 +185,27 @@ int main()
             // Start the Dear ImGui frame
             ImGui_ImplSlag_NewFrame(descriptorPool);
             ImGui_ImplSDL2_NewFrame();
-            ImGui::NewFrame();
+            {
+                IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui::NewFrame");
+                ImGui::NewFrame();
+            }
+
+            ImGui::ShowDemoWindow();
+            if(lazyFont)
+            {
+                ImGui::Begin("Lazy font");
+                ImGui_ImplSlag_PushLazyFont(lazyFont);
+                ImGui::TextUnformatted("\xe4\xbd\xa0\xe5\xa5\xbd\xef\xbc\x8c\xe4\xb8\x96\xe7\x95\x8c");
+                ImGui_ImplSlag_PopLazyFont();
+                ImGui::End();
+            }
+
+            {
+                IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui::Render");
+                ImGui::Render();
+            }
+            //glyphs drawn this frame that aren't cached are rasterized and copied into the atlas, which has to happen outside of a render pass and before any draw data is recorded
+            ImGui_ImplSlag_UpdateFontTexture(commandBuffer);
 
             commandBuffer->setViewPort(0,0,frame->backBuffer()->width(),frame->backBuffer()->height(),1,0);
             commandBuffer->setScissors({{0,0},{frame->backBuffer()->width(),frame->backBuffer()->height()}});
@@ -177,10 +224,6 @@ int main()
 
             slag::Attachment attachment{.texture=renderBuffer,.layout=slag::Texture::RENDER_TARGET,.clearOnLoad=true,.clear={.color={1.0f,0.0f,0.0f,1.0f}}};
             commandBuffer->beginRendering(&attachment,1, nullptr,{.offset={0,0},.extent={renderBuffer->width(),renderBuffer->height()}});
-
-            ImGui::ShowDemoWindow();
-
-            ImGui::Render();
             ImGui_ImplSlag_RenderDrawData(ImGui::GetDrawData(),commandBuffer);
             commandBuffer->endRendering();
             commandBuffer->insertBarrier(
@@ -197,10 +240,15 @@ int main()
             commandBuffer->end();
             if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             {
-                ImGui::UpdatePlatformWindows();
+                {
+                    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui::UpdatePlatformWindows");
+                    ImGui::UpdatePlatformWindows();
+                }
+                IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui::RenderPlatformWindowsDefault");
                 ImGui::RenderPlatformWindowsDefault();
             }
 
+            IMGUI_IMPL_SLAG_TRACE_SCOPE("submit");
             renderQueue->submit(&commandBuffer,1, nullptr,0, nullptr,0,frame);
 
         }
@@ -208,6 +256,9 @@ int main()
 
     }
 
+#ifdef IMGUI_IMPL_SLAG_TRACE
+    ImGui_ImplSlag_WriteTrace("imgui_slag_trace.json");
+#endif
     ImGui_ImplSlag_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
@@ -17,7 +17,40 @@
 //3. This notice may not be removed or altered from any source distribution.
 
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cfloat>
+#include <climits>
+#include <cstdio>
+#include <string>
+#include <chrono>
+#include <memory>
 #include "imgui_impl_slag.h"
+//for ImHashStr, windows are identified by the hash of their name
+#include "imgui_internal.h"
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//private copy of stb_truetype for rasterizing lazy font glyphs, set up the same way imgui_draw.cpp sets up its own
+#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
+#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imstb_truetype.h"
 //fragment shader
 
 //#version 450 core
@@ -223,7 +256,234 @@ const unsigned char DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA[]  = {
         0x1d, 0x00, 0x00, 0x00, 0xfd, 0x00, 0x01, 0x00, 0x38, 0x00, 0x01, 0x00
 };
 
+//every other shader is kept as glsl in shaders/ and embedded in the checked in imgui_impl_slag_shaders.h, after editing one turn on the SLAG_IMGUI_BACKEND_COMPILE_SHADERS cmake option to write the header again. By hand, for each shader:
+//glslc --target-env=vulkan1.2 -O -o build/shaders/bindless.frag.spv shaders/bindless.frag
+//spirv-val --target-env vulkan1.2 build/shaders/bindless.frag.spv
+//and then once for all of them:
+//cmake -DSHADER_DIR=build/shaders -DSHADERS="bindless.vert;bindless.frag;..." -DOUTPUT=imgui_impl_slag_shaders.h -P shaders/embed_shaders.cmake
+#include "imgui_impl_slag_shaders.h"
+
+//shaders each ImGui_ImplSlag_Pipeline is made from
+struct ImGui_ImplSlag_PipelineShaders
+{
+    const unsigned char* vertexShader;
+    size_t vertexShaderLength;
+    const unsigned char* fragmentShader;
+    size_t fragmentShaderLength;
+    bool compactVertices;
+};
+const ImGui_ImplSlag_PipelineShaders IMGUI_IMPL_SLAG_PIPELINE_SHADERS[ImGui_ImplSlag_Pipeline_COUNT] =
+{
+    {DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA),true},
+    {DEAR_IMGUI_SLAG_IMPL_BINDLESS_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_BINDLESS_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_BINDLESS_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_BINDLESS_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_BINDLESS_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_BINDLESS_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_BINDLESS_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_BINDLESS_FRAG_SHADER_DATA),true},
+    {DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_ALPHA_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_ALPHA_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_ALPHA_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_ALPHA_FRAG_SHADER_DATA),true},
+    {DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_GRAYSCALE_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_GRAYSCALE_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_GRAYSCALE_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_GRAYSCALE_FRAG_SHADER_DATA),true},
+    {DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_SDF_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_SDF_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_SDF_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_SDF_FRAG_SHADER_DATA),true},
+    {DEAR_IMGUI_SLAG_IMPL_BINDLESS_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_BINDLESS_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_BINDLESS_SDF_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_BINDLESS_SDF_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_BINDLESS_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_BINDLESS_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_BINDLESS_SDF_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_BINDLESS_SDF_FRAG_SHADER_DATA),true},
+    {DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_COMPOSITE_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPOSITE_FRAG_SHADER_DATA),false},
+    {DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPACT_VERT_SHADER_DATA),DEAR_IMGUI_SLAG_IMPL_COMPOSITE_FRAG_SHADER_DATA,sizeof(DEAR_IMGUI_SLAG_IMPL_COMPOSITE_FRAG_SHADER_DATA),true},
+};
+//bump whenever ImGui_ImplSlag_Pipeline changes, older pipeline cache data is ignored
+#define IMGUI_IMPL_SLAG_PIPELINE_CACHE_VERSION 1
+struct ImGui_ImplSlag_PipelineCacheData
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t pipelines;
+};
+//set before init from a previous run's pipeline cache data
+uint32_t IMGUI_IMPL_SLAG_PREWARM_PIPELINES = 0;
 void* (*IMGUI_IMPL_SLAG_GET_NATIVE_WINDOW_HANDLE)(ImGuiViewport* fromViewport)=nullptr;
+//set on worker threads while ImGui_ImplSlag_RenderPlatformWindowsParallel records on them
+thread_local bool IMGUI_IMPL_SLAG_RECORDING_IN_PARALLEL = false;
+thread_local ImGui_ImplSlag_RenderState* IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE = nullptr;
+//the context ImGui_ImplSlag_RenderPlatformWindowsParallel was called in, made current on its workers when every thread has its own
+ImGuiContext* IMGUI_IMPL_SLAG_RECORDING_CONTEXT = nullptr;
+
+#ifdef IMGUI_IMPL_SLAG_TRACE
+struct ImGui_ImplSlag_TraceEvent
+{
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+};
+//an event as it's stored, sequence is its index + 1 once written and 0 while it's being overwritten, so a reader on another thread can tell a slot that was reused underneath it
+struct ImGui_ImplSlag_TraceSlot
+{
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> start{0};
+    std::atomic<uint64_t> duration{0};
+};
+//only the thread it belongs to writes to it, count is published after each event so the trace can be read from another thread
+struct ImGui_ImplSlag_TraceBuffer
+{
+    uint32_t threadIndex = 0;
+    //events ever recorded, the newest IMGUI_IMPL_SLAG_TRACE_EVENTS are in events at count % IMGUI_IMPL_SLAG_TRACE_EVENTS
+    std::atomic<uint64_t> count{0};
+    std::array<ImGui_ImplSlag_TraceSlot,IMGUI_IMPL_SLAG_TRACE_EVENTS> events;
+};
+//every buffer ever handed out, kept after its thread exits so its scopes still make it into the trace. The mutex is only taken by a thread's first and last scope and by ImGui_ImplSlag_WriteTrace
+std::mutex IMGUI_IMPL_SLAG_TRACE_MUTEX;
+std::vector<std::unique_ptr<ImGui_ImplSlag_TraceBuffer>> IMGUI_IMPL_SLAG_TRACE_BUFFERS;
+//buffers of threads that have exited, a new thread carries on in one of these instead of allocating another
+std::vector<ImGui_ImplSlag_TraceBuffer*> IMGUI_IMPL_SLAG_FREE_TRACE_BUFFERS;
+//owns the thread's buffer until the thread exits, then hands it to the free list
+struct ImGui_ImplSlag_ThreadTraceBuffer
+{
+    ImGui_ImplSlag_TraceBuffer* buffer = nullptr;
+    ~ImGui_ImplSlag_ThreadTraceBuffer()
+    {
+        if(buffer)
+        {
+            std::lock_guard<std::mutex> lock(IMGUI_IMPL_SLAG_TRACE_MUTEX);
+            IMGUI_IMPL_SLAG_FREE_TRACE_BUFFERS.push_back(buffer);
+        }
+    }
+};
+thread_local ImGui_ImplSlag_ThreadTraceBuffer IMGUI_IMPL_SLAG_THREAD_TRACE_BUFFER;
+
+uint64_t ImGui_Slag_TraceNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+ImGui_ImplSlag_TraceScope::ImGui_ImplSlag_TraceScope(const char* scopeName)
+{
+    name = scopeName;
+    start = ImGui_Slag_TraceNow();
+}
+ImGui_ImplSlag_TraceScope::~ImGui_ImplSlag_TraceScope()
+{
+    uint64_t end = ImGui_Slag_TraceNow();
+    auto buffer = IMGUI_IMPL_SLAG_THREAD_TRACE_BUFFER.buffer;
+    if(buffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(IMGUI_IMPL_SLAG_TRACE_MUTEX);
+        if(!IMGUI_IMPL_SLAG_FREE_TRACE_BUFFERS.empty())
+        {
+            //the exited thread's newest scopes stay until this one's overwrite them, on the same track
+            buffer = IMGUI_IMPL_SLAG_FREE_TRACE_BUFFERS.back();
+            IMGUI_IMPL_SLAG_FREE_TRACE_BUFFERS.pop_back();
+        }
+        else
+        {
+            IMGUI_IMPL_SLAG_TRACE_BUFFERS.push_back(std::make_unique<ImGui_ImplSlag_TraceBuffer>());
+            buffer = IMGUI_IMPL_SLAG_TRACE_BUFFERS.back().get();
+            buffer->threadIndex = (uint32_t)IMGUI_IMPL_SLAG_TRACE_BUFFERS.size();
+        }
+        IMGUI_IMPL_SLAG_THREAD_TRACE_BUFFER.buffer = buffer;
+    }
+    uint64_t count = buffer->count.load(std::memory_order_relaxed);
+    ImGui_ImplSlag_TraceSlot& slot = buffer->events[count%IMGUI_IMPL_SLAG_TRACE_EVENTS];
+    slot.sequence.store(0,std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name,std::memory_order_relaxed);
+    slot.start.store(start,std::memory_order_relaxed);
+    slot.duration.store(end-start,std::memory_order_relaxed);
+    slot.sequence.store(count+1,std::memory_order_release);
+    buffer->count.store(count+1,std::memory_order_release);
+}
+//copies out the event with the given index, false if its slot has been reused or is being written to
+bool ImGui_Slag_ReadTraceEvent(const ImGui_ImplSlag_TraceBuffer* buffer, uint64_t index, ImGui_ImplSlag_TraceEvent& event)
+{
+    const ImGui_ImplSlag_TraceSlot& slot = buffer->events[index%IMGUI_IMPL_SLAG_TRACE_EVENTS];
+    if(slot.sequence.load(std::memory_order_acquire) != index+1)
+    {
+        return false;
+    }
+    event.name = slot.name.load(std::memory_order_relaxed);
+    event.start = slot.start.load(std::memory_order_relaxed);
+    event.duration = slot.duration.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == index+1;
+}
+#endif
+
+//a font added through ImGui_ImplSlag_AddLazyFont
+struct ImGui_ImplSlag_LazyFont
+{
+    //owned by the font atlas
+    const void* fontData = nullptr;
+    //zero terminated pairs of codepoints that are rasterized on first use
+    std::vector<ImWchar> lazyGlyphRanges;
+    stbtt_fontinfo fontInfo;
+    float scale = 0.0f;
+};
+//lazy fonts are added before there's any backend data, so they're kept here until shutdown
+std::vector<ImGui_ImplSlag_LazyFont*> IMGUI_IMPL_SLAG_LAZY_FONTS;
+
+//distance field of an sdf font glyph, waiting for init to copy it into its rect of the atlas
+struct ImGui_ImplSlag_SdfGlyph
+{
+    int rect = 0;
+    int width = 0;
+    int height = 0;
+    unsigned char* distances = nullptr;
+};
+std::vector<ImGui_ImplSlag_SdfGlyph> IMGUI_IMPL_SLAG_SDF_GLYPHS;
+//set before init to build the font atlas on a worker thread
+bool IMGUI_IMPL_SLAG_ASYNC_FONT_BUILD = false;
+//set before init to load built font atlases from, and save them to, this directory
+std::string IMGUI_IMPL_SLAG_FONT_CACHE_DIRECTORY;
+//job system given to ImGui_ImplSlag_SetJobSystem before init, which builds the font atlas with it
+ImGui_ImplSlag_ParallelFor IMGUI_IMPL_SLAG_PARALLEL_FOR = nullptr;
+void* IMGUI_IMPL_SLAG_PARALLEL_FOR_USER_DATA = nullptr;
+uint32_t IMGUI_IMPL_SLAG_MAX_UPLOAD_JOBS = 1;
+size_t IMGUI_IMPL_SLAG_MIN_UPLOAD_JOB_BYTES = 0;
+
+//read only view of a whole file
+struct ImGui_ImplSlag_MappedFile
+{
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+};
+//bump whenever the layout of cache files changes
+#define IMGUI_IMPL_SLAG_FONT_CACHE_VERSION 1
+struct ImGui_ImplSlag_FontCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    int32_t width;
+    int32_t height;
+    int32_t texelSize;
+    int32_t fontCount;
+    int32_t customRectCount;
+    int32_t packIdMouseCursors;
+    int32_t packIdLines;
+    ImVec2 texUvWhitePixel;
+    ImVec4 texUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    uint64_t pixelsOffset;
+};
+//everything a build writes to an ImFont, other than its glyph tables which follow it in the file
+struct ImGui_ImplSlag_FontCacheFont
+{
+    float fontSize;
+    float ascent;
+    float descent;
+    float fallbackAdvanceX;
+    float ellipsisWidth;
+    float ellipsisCharStep;
+    int32_t glyphCount;
+    int32_t indexAdvanceCount;
+    int32_t indexLookupCount;
+    int32_t fallbackGlyph;
+    int32_t metricsTotalSurface;
+    uint32_t ellipsisChar;
+    uint32_t fallbackChar;
+    int32_t ellipsisCharCount;
+    ImU8 used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8];
+};
 class ImGuiFrameResources: public slag::FrameResources
 {
 public:
@@ -249,6 +509,167 @@ public:
     }
 };
 
+#define IMGUI_IMPL_SLAG_RING_BUFFER_GRANULARITY 256
+
+slag::Buffer* ImGui_Slag_NewBuffer(size_t size, slag::Buffer::Usage usage)
+{
+    return slag::Buffer::newBuffer(size,slag::Buffer::CPU_AND_GPU,usage);
+}
+void ImGui_Slag_DeleteBuffer(slag::Buffer* buffer)
+{
+    delete buffer;
+}
+//how ring and resident buffers make and free their gpu buffers, tests swap these to exercise them without a device
+slag::Buffer* (*IMGUI_IMPL_SLAG_NEW_BUFFER)(size_t size, slag::Buffer::Usage usage) = ImGui_Slag_NewBuffer;
+void (*IMGUI_IMPL_SLAG_DELETE_BUFFER)(slag::Buffer* buffer) = ImGui_Slag_DeleteBuffer;
+
+ImGui_ImplSlag_RingBuffer::ImGui_ImplSlag_RingBuffer(size_t initialSize, slag::Buffer::Usage bufferUsage, size_t framesInFlight)
+{
+    usage = bufferUsage;
+    frameStarts = std::vector<uint64_t>(framesInFlight, 0);
+    if(initialSize > 0)
+    {
+        capacity = ((initialSize + IMGUI_IMPL_SLAG_RING_BUFFER_GRANULARITY - 1) / IMGUI_IMPL_SLAG_RING_BUFFER_GRANULARITY) * IMGUI_IMPL_SLAG_RING_BUFFER_GRANULARITY;
+        buffer = IMGUI_IMPL_SLAG_NEW_BUFFER(capacity,usage);
+    }
+}
+ImGui_ImplSlag_RingBuffer::~ImGui_ImplSlag_RingBuffer()
+{
+    for(auto& retired: retiredBuffers)
+    {
+        IMGUI_IMPL_SLAG_DELETE_BUFFER(retired.first);
+    }
+    if(buffer)
+    {
+        IMGUI_IMPL_SLAG_DELETE_BUFFER(buffer);
+    }
+}
+void ImGui_ImplSlag_RingBuffer::beginFrame(size_t frameIndex)
+{
+    currentFrame = frameIndex;
+    //everything this slot allocated last time is done on the gpu, it's new allocations start at the head
+    frameStarts[currentFrame] = head;
+    for(size_t i=0; i<retiredBuffers.size();)
+    {
+        retiredBuffers[i].second--;
+        if(retiredBuffers[i].second == 0)
+        {
+            IMGUI_IMPL_SLAG_DELETE_BUFFER(retiredBuffers[i].first);
+            retiredBuffers.erase(retiredBuffers.begin()+i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+size_t ImGui_ImplSlag_RingBuffer::allocate(size_t size, size_t alignment)
+{
+    uint64_t tail = head;
+    for(auto start: frameStarts)
+    {
+        if(start < tail)
+        {
+            tail = start;
+        }
+    }
+    uint64_t start = ((head + alignment - 1) / alignment) * alignment;
+    if(capacity > 0 && start % capacity + size > capacity)
+    {
+        //not enough room before the end, wrap back to the beginning
+        start += capacity - start % capacity;
+    }
+    if(buffer == nullptr || start + size - tail > capacity)
+    {
+        //frames in flight are using the whole buffer, replace it with a bigger one and let the old one retire once they finish
+        size_t newCapacity = capacity > 0 ? capacity * 2 : IMGUI_IMPL_SLAG_RING_BUFFER_GRANULARITY;
+        while(newCapacity < size * 2)
+        {
+            newCapacity *= 2;
+        }
+        if(buffer)
+        {
+            retiredBuffers.push_back({buffer,frameStarts.size()});
+            reallocations++;
+        }
+        capacity = newCapacity;
+        buffer = IMGUI_IMPL_SLAG_NEW_BUFFER(capacity,usage);
+        head = 0;
+        tail = 0;
+        start = 0;
+        for(auto& frameStart: frameStarts)
+        {
+            frameStart = 0;
+        }
+    }
+    head = start + size;
+    if(head - tail > highWaterMark)
+    {
+        highWaterMark = head - tail;
+    }
+    return start % capacity;
+}
+
+ImGui_ImplSlag_ResidentBuffer::ImGui_ImplSlag_ResidentBuffer(uint32_t elementCapacity, size_t elementSize, slag::Buffer::Usage usage)
+{
+    capacity = elementCapacity;
+    buffer = IMGUI_IMPL_SLAG_NEW_BUFFER(elementCapacity*elementSize,usage);
+    freeRanges.push_back({0,elementCapacity});
+}
+ImGui_ImplSlag_ResidentBuffer::~ImGui_ImplSlag_ResidentBuffer()
+{
+    IMGUI_IMPL_SLAG_DELETE_BUFFER(buffer);
+}
+bool ImGui_ImplSlag_ResidentBuffer::allocate(uint32_t count, uint32_t& first)
+{
+    for(size_t i=0; i<freeRanges.size(); i++)
+    {
+        auto& range = freeRanges[i];
+        if(range.second >= count)
+        {
+            first = range.first;
+            range.first += count;
+            range.second -= count;
+            if(range.second == 0)
+            {
+                freeRanges.erase(freeRanges.begin()+i);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+void ImGui_ImplSlag_ResidentBuffer::free(uint32_t first, uint32_t count, int retireFrame)
+{
+    retiringRanges.push_back({{first,count},retireFrame});
+}
+void ImGui_ImplSlag_ResidentBuffer::collect(int frame)
+{
+    for(size_t i=0; i<retiringRanges.size();)
+    {
+        if(retiringRanges[i].second > frame)
+        {
+            i++;
+            continue;
+        }
+        auto range = retiringRanges[i].first;
+        retiringRanges.erase(retiringRanges.begin()+i);
+        //keep the free list sorted and merged with its neighbours so big lists can still find room
+        auto position = std::lower_bound(freeRanges.begin(),freeRanges.end(),range);
+        position = freeRanges.insert(position,range);
+        if(position+1 != freeRanges.end() && position->first+position->second == (position+1)->first)
+        {
+            position->second += (position+1)->second;
+            freeRanges.erase(position+1);
+        }
+        if(position != freeRanges.begin() && (position-1)->first+(position-1)->second == position->first)
+        {
+            (position-1)->second += position->second;
+            freeRanges.erase(position);
+        }
+    }
+}
+
 slag::FrameResources* ImGui_Slag_CreateFrameResources(size_t frameIndex, slag::Swapchain* swapchain)
 {
     return new ImGuiFrameResources();
@@ -280,13 +701,49 @@ void ImGui_Slag_CreateWindow(ImGuiViewport* viewport)
             break;
     }
 
-    auto viewportData = new ImGui_ImplSlag_ViewportData(slag::Swapchain::newSwapchain(platformData,viewport->Size.x,viewport->Size.y,3,slag::Swapchain::MAILBOX,slagData->backBufferFormat,ImGui_Slag_CreateFrameResources),false);
+    ImGui_ImplSlag_ViewportConfig config = slagData->viewportConfig;
+    if(slagData->viewportConfigCallback)
+    {
+        config = slagData->viewportConfigCallback(viewport,slagData->viewportConfig,slagData->viewportConfigUserData);
+    }
+    assert(config.imageCount > 0 && config.imageCount <= IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT && "Viewport image count must be between 1 and IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT");
+
+    auto viewportData = new ImGui_ImplSlag_ViewportData(slag::Swapchain::newSwapchain(platformData,viewport->Size.x,viewport->Size.y,config.imageCount,config.presentMode,slagData->backBufferFormat,ImGui_Slag_CreateFrameResources),false,slagData->vertexUploadBufferSize,slagData->indexUploadBufferSize);
     viewportData->swapchain->next();
     viewport->RendererUserData = viewportData;
 }
+void ImGui_Slag_ReleaseWindowCacheTexture(ImGui_ImplSlag_WindowCache* cache)
+{
+    if(cache->texture)
+    {
+        ImGui_ImplSlag_RemoveTexture(cache->textureId,true);
+        cache->texture = nullptr;
+        cache->textureId = 0;
+        cache->needsRasterizing = false;
+    }
+}
+void ImGui_Slag_ClearWindowCaches(ImGui_ImplSlag_ViewportData* viewportData)
+{
+    for(auto& cache: viewportData->windowCaches)
+    {
+        ImGui_Slag_ReleaseWindowCacheTexture(cache.second);
+        delete cache.second;
+    }
+    viewportData->windowCaches.clear();
+    if(viewportData->windowCacheTarget)
+    {
+        ImGui_ImplSlag_DestroyRenderTarget(viewportData->windowCacheTarget);
+        viewportData->windowCacheTarget = nullptr;
+    }
+    viewportData->windowCacheFrame = -1;
+}
 void ImGui_Slag_DestroyWindow(ImGuiViewport* viewport)
 {
     auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(ImGui::GetIO().BackendRendererUserData);
+    rendererData->vertexHighWaterMark = std::max(rendererData->vertexHighWaterMark,viewportData->vertexBuffer.highWaterMark);
+    rendererData->indexHighWaterMark = std::max(rendererData->indexHighWaterMark,viewportData->indexBuffer.highWaterMark);
+    ImGui_Slag_ClearWindowCaches(viewportData);
     delete viewportData;
     viewport->RendererUserData = nullptr;
 }
@@ -294,294 +751,3697 @@ void ImGui_Slag_SetWindowSize(ImGuiViewport* viewport, ImVec2 newSize)
 {
     auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
     viewportData->swapchain->resize(newSize.x,newSize.y);
+    viewportData->forceRedraw = true;
+    viewportData->backBufferHistory.clear();
 }
-void ImGui_Slag_RenderWindow(ImGuiViewport* viewport, void* unknown)
+uint64_t ImGui_Slag_HashBytes(const void* data, size_t size, uint64_t hash)
 {
-    ImGuiIO& io = ImGui::GetIO();
-
-    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
-    auto frame = viewportData->swapchain->currentFrame();
-    if(frame)
+    //fnv style mixing, 8 bytes at a time, draw data is too big to hash byte by byte every frame
+    const uint64_t prime = 0x100000001b3ull;
+    auto bytes = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+    for(; i+8 <= size; i+=8)
     {
-        auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
-        auto resources = static_cast<ImGuiFrameResources*>(frame->resources);
-        auto commandBuffer = resources->commandBuffer;
-        auto renderBuffer = frame->backBuffer();
-
-        commandBuffer->begin();
-        commandBuffer->bindDescriptorPool(rendererData->descriptorPool);
-        commandBuffer->insertBarrier(
-                {.texture=renderBuffer,
-                 .oldLayout=slag::Texture::UNDEFINED,
-                 .newLayout=slag::Texture::RENDER_TARGET,
-                 .accessBefore=slag::BarrierAccessFlags::NONE,
-                 .accessAfter=slag::BarrierAccessFlags::COLOR_ATTACHMENT_WRITE,
-                 .syncBefore = slag::PipelineStageFlags::NONE,
-                 .syncAfter = slag::PipelineStageFlags::COLOR_ATTACHMENT
-                }
-         );
-
-        slag::Attachment attachment{.texture=renderBuffer,.layout=slag::Texture::RENDER_TARGET,.clearOnLoad=true,.clear={.color={0.0f,0.0f,0.0f,1.0f}}};
-        commandBuffer->beginRendering(&attachment,1, nullptr,{.offset={0,0},.extent={renderBuffer->width(),renderBuffer->height()}});
-
-        ImGui_ImplSlag_RenderDrawData(viewport->DrawData,commandBuffer);
-        commandBuffer->endRendering();
-        commandBuffer->insertBarrier(
-                {.texture=frame->backBuffer(),
-                        .oldLayout=slag::Texture::RENDER_TARGET,
-                        .newLayout=slag::Texture::PRESENT,
-                        .accessBefore=slag::BarrierAccessFlags::COLOR_ATTACHMENT_WRITE,
-                        .accessAfter=slag::BarrierAccessFlags::NONE,
-                        .syncBefore = slag::PipelineStageFlags::COLOR_ATTACHMENT,
-                        .syncAfter = slag::PipelineStageFlags::NONE
-                }
-        );
-
-        commandBuffer->end();
-
-        slag::SlagLib::graphicsCard()->graphicsQueue()->submit(&commandBuffer, 1, nullptr, 0, nullptr, 0, frame);
+        uint64_t word;
+        memcpy(&word,bytes+i,8);
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+    for(; i<size; i++)
+    {
+        hash = (hash ^ bytes[i]) * prime;
     }
+    return hash;
 }
-void ImGui_Slag_SwapBuffers(ImGuiViewport* viewport, void* unknown)
+void ImGui_Slag_UseCompositePipeline(const ImDrawList* drawList, const ImDrawCmd* cmd);
+void ImGui_Slag_UseSdfPipeline(const ImDrawList* drawList, const ImDrawCmd* cmd);
+void ImGui_Slag_BindPipeline(ImGui_ImplSlag_Data* rendererData, slag::CommandBuffer* commandBuffer, slag::ShaderPipeline* pipeline);
+//pipeline one of the backend's own callbacks binds, null for any other callback
+slag::ShaderPipeline* ImGui_Slag_InternalCallbackPipeline(ImGui_ImplSlag_Data* rendererData, ImDrawCallback callback)
 {
-    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
-    viewportData->swapchain->next();
+    if(callback == ImGui_Slag_UseCompositePipeline)
+    {
+        return rendererData->compactVertices ? rendererData->compactCompositeShaderPipeline : rendererData->compositeShaderPipeline;
+    }
+    if(callback == ImGui_Slag_UseSdfPipeline)
+    {
+        slag::ShaderPipeline* pipeline = nullptr;
+        if(rendererData->bindless)
+        {
+            pipeline = rendererData->compactVertices ? rendererData->compactBindlessSdfShaderPipeline : rendererData->bindlessSdfShaderPipeline;
+        }
+        else
+        {
+            pipeline = rendererData->compactVertices ? rendererData->compactSdfShaderPipeline : rendererData->sdfShaderPipeline;
+        }
+        return pipeline;
+    }
+    return nullptr;
 }
-bool ImGui_ImplSlag_Init(slag::Swapchain* mainSwapchain, slag::PlatformData platformData, void* (*extractNativeHandle)(ImGuiViewport* fromViewport), slag::Sampler* sampler, slag::Pixels::Format backBufferFormat)
+//switches to the pipeline that draws cached windows, the following ResetRenderState switches back
+void ImGui_Slag_UseCompositePipeline(const ImDrawList*, const ImDrawCmd*)
 {
-    //set backend data
-    ImGuiIO& io = ImGui::GetIO();
-    io.BackendRendererName = "imgui_impl_slag";
-    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
-    io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;
-    auto backendData = new ImGui_ImplSlag_Data();
-    io.BackendRendererUserData = backendData;
-
-    slag::VertexDescription vertexDescription(1);
-    vertexDescription.add(slag::GraphicsTypes::VECTOR2, offsetof(ImDrawVert,pos),0);
-    vertexDescription.add(slag::GraphicsTypes::VECTOR2, offsetof(ImDrawVert,uv),0);
-    vertexDescription.add(slag::GraphicsTypes::UNSIGNED_INTEGER, offsetof(ImDrawVert,col),0);
-
-    slag::FrameBufferDescription frameBufferDescription;
-    frameBufferDescription.addColorTarget(backBufferFormat);
-
-    slag::ShaderModule modules[2]
-    {
-        slag::ShaderModule (slag::ShaderStageFlags::VERTEX, (void*) DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA, sizeof(DEAR_IMGUI_SLAG_IMPL_VERT_SHADER_DATA)),
-        slag::ShaderModule (slag::ShaderStageFlags::FRAGMENT, (void*) DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA, sizeof(DEAR_IMGUI_SLAG_IMPL_FRAG_SHADER_DATA))
-    };
-    slag::ShaderProperties shaderProperties;
-    backendData->shaderPipeline = slag::ShaderPipeline::newShaderPipeline(modules,2, nullptr,0,shaderProperties,&vertexDescription,frameBufferDescription);
-    backendData->sampler = sampler;
-    backendData->platformData = platformData;
-    backendData->backBufferFormat = backBufferFormat;
-
-    //create dear imgui managed resources(just the texture, the descriptor bundle has to have a current descriptor pool, which requires an active frame)
-    unsigned char* pixels;
-    int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
-    size_t upload_size = width * height * 4 * sizeof(char);
-    backendData->fontsTexture = slag::Texture::newTexture(pixels,slag::Pixels::R8G8B8A8_UNORM,width,height,1,slag::TextureUsageFlags::SAMPLED_IMAGE,slag::Texture::SHADER_RESOURCE);
-
-    auto viewportData = new ImGui_ImplSlag_ViewportData(mainSwapchain, true);
-
-    auto mainViewport = ImGui::GetMainViewport();
-    mainViewport->RendererUserData = viewportData;
-
-    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
-    platformIo.Renderer_CreateWindow = ImGui_Slag_CreateWindow;
-    platformIo.Renderer_DestroyWindow = ImGui_Slag_DestroyWindow;
-    platformIo.Renderer_SetWindowSize = ImGui_Slag_SetWindowSize;
-    platformIo.Renderer_RenderWindow = ImGui_Slag_RenderWindow;
-    platformIo.Renderer_SwapBuffers = ImGui_Slag_SwapBuffers;
-
-    IMGUI_IMPL_SLAG_GET_NATIVE_WINDOW_HANDLE = extractNativeHandle;
-
-    return true;
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(ImGui::GetIO().BackendRendererUserData);
+    ImGui_Slag_BindPipeline(rendererData,IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE->commandBuffer,ImGui_Slag_InternalCallbackPipeline(rendererData,ImGui_Slag_UseCompositePipeline));
 }
-
-void ImGui_ImplSlag_Shutdown()
+//switches to the pipeline that draws signed distance field text, the following ResetRenderState switches back
+void ImGui_Slag_UseSdfPipeline(const ImDrawList*, const ImDrawCmd*)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    auto backend = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
-    //clean up IMGUI managed resources
-    delete backend->fontsTexture;
-    delete backend->fontsTextureBundle;
-    delete backend->shaderPipeline;
-
-    delete backend;
-    io.BackendRendererUserData = nullptr;
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(ImGui::GetIO().BackendRendererUserData);
+    auto pipeline = ImGui_Slag_InternalCallbackPipeline(rendererData,ImGui_Slag_UseSdfPipeline);
+    assert(pipeline && "sdf pipelines weren't made, use ImGui_ImplSlag_PushSdfText");
+    ImGui_Slag_BindPipeline(rendererData,IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE->commandBuffer,pipeline);
 }
-
-void ImGui_ImplSlag_NewFrame(slag::DescriptorPool* framePool)
+//callbacks the backend knows the effect of, anything else makes draw data impossible to compare
+bool ImGui_Slag_IsInternalCallback(ImDrawCallback callback)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
-    rendererData->descriptorPool = framePool;
-    if(rendererData->fontsTextureBundle== nullptr)
+    return callback == ImDrawCallback_ResetRenderState || callback == ImGui_Slag_UseCompositePipeline || callback == ImGui_Slag_UseSdfPipeline;
+}
+bool ImGui_Slag_HashDrawList(const ImDrawList* drawList, uint64_t& hash)
+{
+    hash = ImGui_Slag_HashBytes(drawList->VtxBuffer.Data,drawList->VtxBuffer.size_in_bytes(),hash);
+    hash = ImGui_Slag_HashBytes(drawList->IdxBuffer.Data,drawList->IdxBuffer.size_in_bytes(),hash);
+    for(int j=0; j<drawList->CmdBuffer.Size; j++)
     {
-        rendererData->fontsTextureBundle = new slag::DescriptorBundle(framePool->makeBundle(rendererData->shaderPipeline->descriptorGroup(0)));
+        const ImDrawCmd& cmd = drawList->CmdBuffer[j];
+        if(cmd.UserCallback != nullptr && !ImGui_Slag_IsInternalCallback(cmd.UserCallback))
+        {
+            return false;
+        }
+        hash = ImGui_Slag_HashBytes(&cmd.ClipRect,sizeof(ImVec4),hash);
+        hash = ImGui_Slag_HashBytes(&cmd.TextureId,sizeof(ImTextureID),hash);
+        hash = ImGui_Slag_HashBytes(&cmd.VtxOffset,sizeof(unsigned int),hash);
+        hash = ImGui_Slag_HashBytes(&cmd.IdxOffset,sizeof(unsigned int),hash);
+        hash = ImGui_Slag_HashBytes(&cmd.ElemCount,sizeof(unsigned int),hash);
     }
-    else
+    return true;
+}
+bool ImGui_Slag_HashDrawData(ImGui_ImplSlag_Data* rendererData, ImDrawData* drawData, uint64_t& hash)
+{
+    hash = 0xcbf29ce484222325ull;
+    hash = ImGui_Slag_HashBytes(&drawData->DisplayPos,sizeof(ImVec2),hash);
+    hash = ImGui_Slag_HashBytes(&drawData->DisplaySize,sizeof(ImVec2),hash);
+    hash = ImGui_Slag_HashBytes(&drawData->FramebufferScale,sizeof(ImVec2),hash);
+    hash = ImGui_Slag_HashBytes(&rendererData->bindlessVersion,sizeof(rendererData->bindlessVersion),hash);
+    for(int i=0; i<drawData->CmdListsCount; i++)
     {
-        *(rendererData->fontsTextureBundle) = framePool->makeBundle(rendererData->shaderPipeline->descriptorGroup(0));
-
+        if(!ImGui_Slag_HashDrawList(drawData->CmdLists[i],hash))
+        {
+            return false;
+        }
     }
-    rendererData->fontsTextureBundle->setSamplerAndTexture(0,0,rendererData->fontsTexture, slag::Texture::SHADER_RESOURCE,rendererData->sampler);
-    io.Fonts->SetTexID((ImTextureID)rendererData->fontsTextureBundle);
+    return true;
 }
-void ImGui_ImplSlag_SetupRenderState(ImDrawData* draw_data, slag::ShaderPipeline* pipeline, slag::CommandBuffer* commandBuffer, slag::Buffer* vertexBuffer, slag::Buffer* indexBuffer, uint32_t frameBufferWidth, uint32_t frameBufferHeight)
+//compares the viewport's draw data against what was last rendered, at most once per imgui frame
+bool ImGui_Slag_ViewportUnchanged(ImGui_ImplSlag_Data* rendererData, ImGuiViewport* viewport)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    auto slagData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
-
-    commandBuffer->bindGraphicsShader(slagData->shaderPipeline);
-
-
-    // Bind Vertex And Index Buffer:
-    if (draw_data->TotalVtxCount > 0)
+    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+    if(!rendererData->skipUnchangedViewports || viewport->DrawData == nullptr)
     {
-        size_t offset = 0;
-        size_t stride = sizeof(ImDrawVert);
-        size_t size = vertexBuffer->size();
-        commandBuffer->bindVertexBuffers(0,&vertexBuffer,&offset,&size,&stride,1);
-        commandBuffer->bindIndexBuffer(indexBuffer,sizeof(ImDrawIdx) == 2 ? slag::Buffer::UINT16: slag::Buffer::UINT32,0);
+        viewportData->forceRedraw = true;
+        return false;
+    }
+    if(viewportData->hashedImGuiFrame != ImGui::GetFrameCount())
+    {
+        viewportData->hashedImGuiFrame = ImGui::GetFrameCount();
+        uint64_t hash = 0;
+        bool comparable = ImGui_Slag_HashDrawData(rendererData,viewport->DrawData,hash);
+        viewportData->unchanged = comparable && !viewportData->forceRedraw && hash == viewportData->drawDataHash;
+        viewportData->drawDataHash = hash;
+        viewportData->forceRedraw = !comparable;
+        if(viewportData->unchanged)
+        {
+            rendererData->elidedViewportFrames++;
+        }
+    }
+    return viewportData->unchanged;
+}
+//returns false when the draw data can't be compared, eg. it has user callbacks
+bool ImGui_Slag_BuildSignatures(ImDrawData* drawData, float frameBufferWidth, float frameBufferHeight, ImVector<ImGui_ImplSlag_DrawSignature>& signatures)
+{
+    signatures.resize(0);
+    ImVec2 clipOff = drawData->DisplayPos;
+    ImVec2 clipScale = drawData->FramebufferScale;
+    for(int i=0; i<drawData->CmdListsCount; i++)
+    {
+        const ImDrawList* drawList = drawData->CmdLists[i];
+        for(int j=0; j<drawList->CmdBuffer.Size; j++)
+        {
+            const ImDrawCmd& cmd = drawList->CmdBuffer[j];
+            if(cmd.UserCallback != nullptr)
+            {
+                if(ImGui_Slag_IsInternalCallback(cmd.UserCallback))
+                {
+                    continue;
+                }
+                return false;
+            }
+            if(cmd.ElemCount == 0)
+            {
+                continue;
+            }
+            //the area the command can touch is where its vertices are, inside its clip rect
+            ImVec4 bounds(FLT_MAX,FLT_MAX,-FLT_MAX,-FLT_MAX);
+            unsigned int minIndex = UINT_MAX;
+            unsigned int maxIndex = 0;
+            for(unsigned int k=0; k<cmd.ElemCount; k++)
+            {
+                unsigned int index = drawList->IdxBuffer[cmd.IdxOffset+k]+cmd.VtxOffset;
+                minIndex = std::min(minIndex,index);
+                maxIndex = std::max(maxIndex,index);
+                const ImVec2& pos = drawList->VtxBuffer[index].pos;
+                bounds.x = std::min(bounds.x,pos.x);
+                bounds.y = std::min(bounds.y,pos.y);
+                bounds.z = std::max(bounds.z,pos.x);
+                bounds.w = std::max(bounds.w,pos.y);
+            }
+            bounds.x = std::max(bounds.x,cmd.ClipRect.x);
+            bounds.y = std::max(bounds.y,cmd.ClipRect.y);
+            bounds.z = std::min(bounds.z,cmd.ClipRect.z);
+            bounds.w = std::min(bounds.w,cmd.ClipRect.w);
+            bounds = ImVec4(std::max(std::floor((bounds.x-clipOff.x)*clipScale.x),0.0f),
+                            std::max(std::floor((bounds.y-clipOff.y)*clipScale.y),0.0f),
+                            std::min(std::ceil((bounds.z-clipOff.x)*clipScale.x),frameBufferWidth),
+                            std::min(std::ceil((bounds.w-clipOff.y)*clipScale.y),frameBufferHeight));
+            if(bounds.z <= bounds.x || bounds.w <= bounds.y)
+            {
+                continue;
+            }
+            ImGui_ImplSlag_DrawSignature signature;
+            signature.bounds = bounds;
+            signature.hash = ImGui_Slag_HashBytes(&cmd.ClipRect,sizeof(ImVec4),0xcbf29ce484222325ull);
+            signature.hash = ImGui_Slag_HashBytes(&cmd.TextureId,sizeof(ImTextureID),signature.hash);
+            signature.hash = ImGui_Slag_HashBytes(drawList->IdxBuffer.Data+cmd.IdxOffset,cmd.ElemCount*sizeof(ImDrawIdx),signature.hash);
+            signature.hash = ImGui_Slag_HashBytes(drawList->VtxBuffer.Data+minIndex,(maxIndex-minIndex+1)*sizeof(ImDrawVert),signature.hash);
+            signatures.push_back(signature);
+        }
+    }
+    return true;
+}
+void ImGui_Slag_AddDamage(ImVector<ImVec4>& damageRects, ImVec4 rect)
+{
+    //keep the rects apart, so nothing inside two of them gets blended twice
+    for(int i=0; i<damageRects.Size; i++)
+    {
+        const ImVec4& other = damageRects[i];
+        if(rect.x < other.z && other.x < rect.z && rect.y < other.w && other.y < rect.w)
+        {
+            rect = ImVec4(std::min(rect.x,other.x),std::min(rect.y,other.y),std::max(rect.z,other.z),std::max(rect.w,other.w));
+            damageRects.erase(damageRects.Data+i);
+            i = -1;
+        }
+    }
+    damageRects.push_back(rect);
+}
+//how far ahead a changed frame is searched for each draw command of the old one before it's considered gone
+#define IMGUI_IMPL_SLAG_DAMAGE_SEARCH_WINDOW 64
+//works out what needs redrawing in the current back buffer, returns false when all of it does. Allocates through imgui, so only on the main thread
+bool ImGui_Slag_PrepareDamage(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_ViewportData* viewportData, ImDrawData* drawData)
+{
+    float frameBufferWidth = (float)viewportData->swapchain->width();
+    float frameBufferHeight = (float)viewportData->swapchain->height();
+    if(viewportData->backBufferHistory.size() != viewportData->swapchain->backBuffers())
+    {
+        viewportData->backBufferHistory = std::vector<ImGui_ImplSlag_BackBufferHistory>(viewportData->swapchain->backBuffers());
+    }
+    auto& history = viewportData->backBufferHistory[viewportData->swapchain->currentFrameIndex()];
+    auto& signatures = viewportData->signatures;
+    if(!ImGui_Slag_BuildSignatures(drawData,frameBufferWidth,frameBufferHeight,signatures))
+    {
+        viewportData->backBufferHistory.clear();
+        return false;
     }
 
-    commandBuffer->setViewPort(0,0,frameBufferWidth,frameBufferHeight,1,0);
-
+    bool partial = history.valid && history.textureVersion == rendererData->bindlessVersion;
+    auto& damageRects = viewportData->damageRects;
+    damageRects.resize(0);
+    if(partial)
     {
-        float scale[2];
-        scale[0] = 2.0f / draw_data->DisplaySize.x;
-        scale[1] = 2.0f / draw_data->DisplaySize.y;
-        float translate[2];
-        translate[0] =  -1.0f - draw_data->DisplayPos.x * scale[0];
-        translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
-        commandBuffer->pushConstants(pipeline,slag::ShaderStageFlags::VERTEX,0,sizeof(float)*2,scale);
-        commandBuffer->pushConstants(pipeline,slag::ShaderStageFlags::VERTEX,sizeof(float)*2,sizeof(float)*2,translate);
-        auto drawList = draw_data->CmdLists.Data[0];
+        //walk both frames in order, matching commands keep their order relative to each other, so only the unmatched ones changed what's on screen
+        auto& old = history.signatures;
+        int oldIndex = 0;
+        for(int i=0; i<signatures.Size; i++)
+        {
+            const ImGui_ImplSlag_DrawSignature& signature = signatures[i];
+            int match = -1;
+            int searchEnd = std::min(old.Size,oldIndex+IMGUI_IMPL_SLAG_DAMAGE_SEARCH_WINDOW);
+            for(int j=oldIndex; j<searchEnd; j++)
+            {
+                if(old[j].hash == signature.hash && memcmp(&old[j].bounds,&signature.bounds,sizeof(ImVec4)) == 0)
+                {
+                    match = j;
+                    break;
+                }
+            }
+            if(match < 0)
+            {
+                ImGui_Slag_AddDamage(damageRects,signature.bounds);
+                continue;
+            }
+            for(; oldIndex<match; oldIndex++)
+            {
+                ImGui_Slag_AddDamage(damageRects,old[oldIndex].bounds);
+            }
+            oldIndex = match+1;
+        }
+        for(; oldIndex<old.Size; oldIndex++)
+        {
+            ImGui_Slag_AddDamage(damageRects,old[oldIndex].bounds);
+        }
+
+        if(damageRects.Size > IMGUI_IMPL_SLAG_MAX_DAMAGE_RECTS)
+        {
+            ImVec4 merged = damageRects[0];
+            for(int i=1; i<damageRects.Size; i++)
+            {
+                merged = ImVec4(std::min(merged.x,damageRects[i].x),std::min(merged.y,damageRects[i].y),std::max(merged.z,damageRects[i].z),std::max(merged.w,damageRects[i].w));
+            }
+            damageRects.resize(0);
+            damageRects.push_back(merged);
+        }
+        float damagedArea = 0;
+        for(int i=0; i<damageRects.Size; i++)
+        {
+            damagedArea += (damageRects[i].z-damageRects[i].x)*(damageRects[i].w-damageRects[i].y);
+        }
+        partial = damagedArea <= frameBufferWidth*frameBufferHeight*IMGUI_IMPL_SLAG_MAX_DAMAGE_AREA;
+    }
+
+    history.signatures.swap(signatures);
+    history.textureVersion = rendererData->bindlessVersion;
+    history.valid = true;
+    if(!partial)
+    {
+        return false;
+    }
 
+    //cover the damaged areas with the clear colour using the font atlas' white pixel
+    if(viewportData->clearList == nullptr)
+    {
+        viewportData->clearList = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    }
+    ImDrawList* clearList = viewportData->clearList;
+    clearList->_ResetForNewFrame();
+    clearList->PushClipRect(drawData->DisplayPos,ImVec2(drawData->DisplayPos.x+drawData->DisplaySize.x,drawData->DisplayPos.y+drawData->DisplaySize.y));
+    clearList->PushTextureID(rendererData->fontsTextureId);
+    for(int i=0; i<damageRects.Size; i++)
+    {
+        const ImVec4& rect = damageRects[i];
+        clearList->AddRectFilled(ImVec2(rect.x/drawData->FramebufferScale.x+drawData->DisplayPos.x,rect.y/drawData->FramebufferScale.y+drawData->DisplayPos.y),
+                                 ImVec2(rect.z/drawData->FramebufferScale.x+drawData->DisplayPos.x,rect.w/drawData->FramebufferScale.y+drawData->DisplayPos.y),
+                                 IM_COL32(0,0,0,255));
     }
+    clearList->_PopUnusedDrawCmd();
+    return true;
 }
-void ImGui_ImplSlag_RenderDrawData(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer)
+//decides which of the viewport's draw lists are cached this frame, creating and releasing textures as needed. Touches shared state, so only on the main thread
+//whether every command of the list samples the font atlas. Other textures, such as the target of an ImGui::Image, can change every frame without the list changing, so lists drawing them aren't cached
+bool ImGui_Slag_DrawsOnlyFont(const ImDrawList* drawList, ImTextureID fontsTextureId)
 {
-    ImGuiIO& io = ImGui::GetIO();
-    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
-    auto rendererViewportData = static_cast<ImGui_ImplSlag_ViewportData*>(draw_data->OwnerViewport->RendererUserData);
-    auto currentIndex = rendererViewportData->swapchain->currentFrameIndex();
-    auto shader = rendererData->shaderPipeline;
-    auto sampler = rendererData->sampler;
-    if(draw_data->TotalVtxCount > 0)
+    for(int j=0; j<drawList->CmdBuffer.Size; j++)
     {
-        if(rendererViewportData->drawDataArrays[currentIndex] == nullptr)
+        const ImDrawCmd& cmd = drawList->CmdBuffer[j];
+        if(cmd.UserCallback == nullptr && cmd.ElemCount != 0 && cmd.TextureId != fontsTextureId)
         {
-            //create new arrays that will fit the data
-            rendererViewportData->drawDataArrays[currentIndex]= slag::Buffer::newBuffer(draw_data->TotalVtxCount*sizeof(ImDrawVert),slag::Buffer::CPU_AND_GPU,slag::Buffer::VERTEX_BUFFER);
-            rendererViewportData->drawDataIndexArrays[currentIndex]= slag::Buffer::newBuffer(draw_data->TotalIdxCount*sizeof(ImDrawIdx),slag::Buffer::CPU_AND_GPU,slag::Buffer::INDEX_BUFFER);
+            return false;
         }
+    }
+    return true;
+}
+void ImGui_Slag_PlanWindowCache(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_ViewportData* viewportData, ImDrawData* drawData)
+{
+    int frame = ImGui::GetFrameCount();
+    if(!rendererData->cacheWindows || rendererData->bindless || drawData == nullptr || viewportData->windowCacheFrame == frame)
+    {
+        return;
+    }
+    viewportData->windowCacheFrame = frame;
+    if(viewportData->windowCacheTarget == nullptr)
+    {
+        viewportData->windowCacheTarget = ImGui_ImplSlag_CreateRenderTarget();
+        viewportData->windowCacheDrawData.CmdLists.reserve(1);
+    }
 
-        if(rendererViewportData->drawDataArrays[currentIndex]->size()< draw_data->TotalVtxCount*sizeof(ImDrawVert) ||
-            rendererViewportData->drawDataArrays[currentIndex]->size()>= draw_data->TotalVtxCount*sizeof(ImDrawVert)*1.75
-        )
+    //lists are in absolute coordinates, so the same list only looks the same if the viewport maps it to the same pixels
+    ImTextureID fontsTextureId = ImGui::GetIO().Fonts->TexID;
+    uint64_t seed = ImGui_Slag_HashBytes(&drawData->DisplayPos,sizeof(ImVec2),0xcbf29ce484222325ull);
+    seed = ImGui_Slag_HashBytes(&drawData->FramebufferScale,sizeof(ImVec2),seed);
+    for(int i=0; i<drawData->CmdListsCount; i++)
+    {
+        const ImDrawList* drawList = drawData->CmdLists[i];
+        uint64_t hash = seed;
+        if(drawList->VtxBuffer.Size == 0 || !ImGui_Slag_HashDrawList(drawList,hash) || !ImGui_Slag_DrawsOnlyFont(drawList,fontsTextureId))
         {
-            delete rendererViewportData->drawDataArrays[currentIndex];
-            rendererViewportData->drawDataArrays[currentIndex]= slag::Buffer::newBuffer(draw_data->TotalVtxCount*sizeof(ImDrawVert),slag::Buffer::CPU_AND_GPU,slag::Buffer::VERTEX_BUFFER);
+            continue;
         }
-        if(rendererViewportData->drawDataIndexArrays[currentIndex]->size()< draw_data->TotalIdxCount*sizeof(ImDrawIdx) ||
-            rendererViewportData->drawDataIndexArrays[currentIndex]->size()>= draw_data->TotalIdxCount*sizeof(ImDrawIdx)*1.75)
+        auto& cache = viewportData->windowCaches[drawList];
+        if(cache == nullptr)
         {
-            delete rendererViewportData->drawDataIndexArrays[currentIndex];
-            rendererViewportData->drawDataIndexArrays[currentIndex]= slag::Buffer::newBuffer(draw_data->TotalIdxCount*sizeof(ImDrawIdx),slag::Buffer::CPU_AND_GPU,slag::Buffer::INDEX_BUFFER);
+            cache = new ImGui_ImplSlag_WindowCache();
         }
-        //copy draw data into buffers
-        auto vertexBuffer = rendererViewportData->drawDataArrays[currentIndex];
-        auto indexBuffer = rendererViewportData->drawDataIndexArrays[currentIndex];
-        size_t vertexOffset = 0;
-        size_t indexOffset = 0;
-        for(int i=0; i<draw_data->CmdListsCount; i++)
+        cache->lastSeenFrame = frame;
+        if(cache->hash != hash)
         {
-            const ImDrawList* draw_list = draw_data->CmdLists[i];
-            auto vsize = draw_list->VtxBuffer.Size*sizeof(ImDrawVert);
-            auto isize = draw_list->IdxBuffer.Size*sizeof(ImDrawIdx);
-            vertexBuffer->update(vertexOffset,draw_list->VtxBuffer.Data,vsize);
-            indexBuffer->update(indexOffset,draw_list->IdxBuffer.Data,isize);
-            vertexOffset+=vsize;
-            indexOffset+=isize;
+            cache->hash = hash;
+            cache->unchangedFrames = 0;
+            ImGui_Slag_ReleaseWindowCacheTexture(cache);
+            continue;
+        }
+        cache->unchangedFrames++;
+        if(cache->texture || cache->unchangedFrames < IMGUI_IMPL_SLAG_WINDOW_CACHE_FRAMES)
+        {
+            continue;
         }
-        auto frameBufferWidth = rendererViewportData->swapchain->width();
-        auto frameBufferHeight = rendererViewportData->swapchain->height();
 
-        ImGui_ImplSlag_SetupRenderState(draw_data,shader,commandBuffer,vertexBuffer,indexBuffer,frameBufferWidth,frameBufferHeight);
-        // Setup render state structure (for callbacks and custom texture bindings)
-        ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
-        ImGui_ImplSlag_RenderState render_state;
-        render_state.commandBuffer = commandBuffer;
-        render_state.shader = shader;
-        platform_io.Renderer_RenderState = &render_state;
+        //the list can only draw where its vertices are, inside its clip rects and the framebuffer
+        ImVec4 bounds(FLT_MAX,FLT_MAX,-FLT_MAX,-FLT_MAX);
+        for(int j=0; j<drawList->VtxBuffer.Size; j++)
+        {
+            const ImVec2& pos = drawList->VtxBuffer[j].pos;
+            bounds = ImVec4(std::min(bounds.x,pos.x),std::min(bounds.y,pos.y),std::max(bounds.z,pos.x),std::max(bounds.w,pos.y));
+        }
+        ImVec4 clip(FLT_MAX,FLT_MAX,-FLT_MAX,-FLT_MAX);
+        for(int j=0; j<drawList->CmdBuffer.Size; j++)
+        {
+            const ImVec4& clipRect = drawList->CmdBuffer[j].ClipRect;
+            clip = ImVec4(std::min(clip.x,clipRect.x),std::min(clip.y,clipRect.y),std::max(clip.z,clipRect.z),std::max(clip.w,clipRect.w));
+        }
+        ImVec2 clipOff = drawData->DisplayPos;
+        ImVec2 clipScale = drawData->FramebufferScale;
+        bounds = ImVec4(std::max(std::floor((std::max(bounds.x,clip.x)-clipOff.x)*clipScale.x),0.0f),
+                        std::max(std::floor((std::max(bounds.y,clip.y)-clipOff.y)*clipScale.y),0.0f),
+                        std::min(std::ceil((std::min(bounds.z,clip.z)-clipOff.x)*clipScale.x),drawData->DisplaySize.x*clipScale.x),
+                        std::min(std::ceil((std::min(bounds.w,clip.w)-clipOff.y)*clipScale.y),drawData->DisplaySize.y*clipScale.y));
+        if(bounds.z <= bounds.x || bounds.w <= bounds.y)
+        {
+            continue;
+        }
+        cache->bounds = bounds;
+        cache->texture = slag::Texture::newTexture(rendererData->backBufferFormat,(uint32_t)(bounds.z-bounds.x),(uint32_t)(bounds.w-bounds.y),1,slag::TextureUsageFlags::SAMPLED_IMAGE | slag::TextureUsageFlags::RENDER_TARGET_ATTACHMENT);
+        cache->textureId = ImGui_ImplSlag_AddTexture(cache->texture,rendererData->sampler);
+        cache->needsRasterizing = true;
 
-        // Will project scissor/clipping rectangles into framebuffer space
-        ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
-        ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+        //a quad covering exactly the cached pixels, drawn with the pipeline that undoes the premultiplication
+        if(cache->compositeList == nullptr)
+        {
+            cache->compositeList = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+        }
+        ImDrawList* compositeList = cache->compositeList;
+        ImVec2 min(bounds.x/clipScale.x+clipOff.x,bounds.y/clipScale.y+clipOff.y);
+        ImVec2 max(bounds.z/clipScale.x+clipOff.x,bounds.w/clipScale.y+clipOff.y);
+        compositeList->_ResetForNewFrame();
+        compositeList->PushClipRect(min,max);
+        compositeList->AddCallback(ImGui_Slag_UseCompositePipeline,nullptr);
+        compositeList->AddImage(cache->textureId,min,max);
+        compositeList->AddCallback(ImDrawCallback_ResetRenderState,nullptr);
+        compositeList->_PopUnusedDrawCmd();
+    }
 
-        size_t vertexDrawOffset = 0;
-        size_t indexDrawOffset = 0;
-        for(int i=0; i< draw_data->CmdListsCount; i++)
+    //lists that weren't drawn this frame, their windows are hidden or gone
+    for(auto it = viewportData->windowCaches.begin(); it != viewportData->windowCaches.end();)
+    {
+        if(it->second->lastSeenFrame != frame)
         {
-            const ImDrawList* draw_list = draw_data->CmdLists[i];
-            for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
-            {
-                const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
-                if (pcmd->UserCallback != nullptr)
-                {
-                    // User callback, registered via ImDrawList::AddCallback()
-                    // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
-                    if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    {
-                        ImGui_ImplSlag_SetupRenderState(draw_data,shader,commandBuffer,vertexBuffer,indexBuffer,frameBufferWidth,frameBufferHeight);
+            ImGui_Slag_ReleaseWindowCacheTexture(it->second);
+            delete it->second;
+            it = viewportData->windowCaches.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+//records the rasterization of newly cached lists and swaps cached lists for their composite quads, must be outside a render pass. Only touches the viewport's own data and doesn't allocate through imgui, so it's safe on worker threads
+void ImGui_Slag_RasterizeWindowCache(ImGui_ImplSlag_ViewportData* viewportData, ImDrawData* drawData, slag::CommandBuffer* commandBuffer)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("rasterize window cache");
+    if(viewportData->windowCaches.empty() || drawData == nullptr)
+    {
+        return;
+    }
+    for(int i=0; i<drawData->CmdListsCount; i++)
+    {
+        ImDrawList* drawList = drawData->CmdLists[i];
+        auto found = viewportData->windowCaches.find(drawList);
+        if(found == viewportData->windowCaches.end() || found->second->texture == nullptr)
+        {
+            continue;
+        }
+        auto cache = found->second;
+        if(cache->needsRasterizing)
+        {
+            commandBuffer->insertBarrier(
+                    {.texture=cache->texture,
+                     .oldLayout=slag::Texture::UNDEFINED,
+                     .newLayout=slag::Texture::RENDER_TARGET,
+                     .accessBefore=slag::BarrierAccessFlags::NONE,
+                     .accessAfter=slag::BarrierAccessFlags::COLOR_ATTACHMENT_WRITE,
+                     .syncBefore = slag::PipelineStageFlags::NONE,
+                     .syncAfter = slag::PipelineStageFlags::COLOR_ATTACHMENT
                     }
-                    else
-                    {
-                        pcmd->UserCallback(draw_list,pcmd);
+            );
+            //draw just this list, with the cached area as the display
+            ImDrawData& listData = viewportData->windowCacheDrawData;
+            listData.Valid = true;
+            listData.CmdLists.resize(0);
+            listData.CmdLists.push_back(drawList);
+            listData.CmdListsCount = 1;
+            listData.TotalVtxCount = drawList->VtxBuffer.Size;
+            listData.TotalIdxCount = drawList->IdxBuffer.Size;
+            listData.FramebufferScale = drawData->FramebufferScale;
+            listData.DisplayPos = ImVec2(cache->bounds.x/drawData->FramebufferScale.x+drawData->DisplayPos.x,cache->bounds.y/drawData->FramebufferScale.y+drawData->DisplayPos.y);
+            listData.DisplaySize = ImVec2((cache->bounds.z-cache->bounds.x)/drawData->FramebufferScale.x,(cache->bounds.w-cache->bounds.y)/drawData->FramebufferScale.y);
+            listData.OwnerViewport = drawData->OwnerViewport;
+            ImGui_ImplSlag_RenderDrawDataToTexture(&listData,commandBuffer,viewportData->windowCacheTarget,cache->texture);
+            commandBuffer->insertBarrier(
+                    {.texture=cache->texture,
+                     .oldLayout=slag::Texture::RENDER_TARGET,
+                     .newLayout=slag::Texture::SHADER_RESOURCE,
+                     .accessBefore=slag::BarrierAccessFlags::COLOR_ATTACHMENT_WRITE,
+                     .accessAfter=slag::BarrierAccessFlags::SHADER_READ,
+                     .syncBefore = slag::PipelineStageFlags::COLOR_ATTACHMENT,
+                     .syncAfter = slag::PipelineStageFlags::FRAGMENT_SHADER
                     }
-                }
-                else
-                {
-                    // Project scissor/clipping rectangles into framebuffer space
-                    ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
-                    ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            );
+            cache->needsRasterizing = false;
+        }
+        drawData->TotalVtxCount += cache->compositeList->VtxBuffer.Size-drawList->VtxBuffer.Size;
+        drawData->TotalIdxCount += cache->compositeList->IdxBuffer.Size-drawList->IdxBuffer.Size;
+        drawData->CmdLists[i] = cache->compositeList;
+    }
+}
+//everything about recording the viewport that allocates through imgui, done on the main thread before it's recorded
+void ImGui_Slag_PrepareWindow(ImGui_ImplSlag_Data* rendererData, ImGuiViewport* viewport)
+{
+    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+    ImGui_Slag_PlanWindowCache(rendererData,viewportData,viewport->DrawData);
+    viewportData->redrawDamaged = rendererData->incrementalPresentation && viewport->DrawData && viewportData->swapchain->currentFrame() && ImGui_Slag_PrepareDamage(rendererData,viewportData,viewport->DrawData);
+    if(viewportData->redrawDamaged)
+    {
+        //room for the clear list, so putting it in front doesn't reallocate while recording
+        viewport->DrawData->CmdLists.reserve(viewport->DrawData->CmdLists.Size+1);
+    }
+}
+//records the viewport into its current frame's command buffer after ImGui_Slag_PrepareWindow, returns false if there is no frame to render to
+bool ImGui_Slag_RecordWindow(ImGuiViewport* viewport)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("record window");
+    ImGuiIO& io = ImGui::GetIO();
 
-                    // Clamp to viewport as vkCmdSetScissor() won't accept values that are off bounds
-                    if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
-                    if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
-                    if (clip_max.x > frameBufferWidth) { clip_max.x = (float)frameBufferWidth; }
-                    if (clip_max.y > frameBufferHeight) { clip_max.y = (float)frameBufferHeight; }
-                    if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
-                        continue;
+    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+    auto frame = viewportData->swapchain->currentFrame();
+    if(frame)
+    {
+        auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+        auto resources = static_cast<ImGuiFrameResources*>(frame->resources);
+        auto commandBuffer = resources->commandBuffer;
+        auto renderBuffer = frame->backBuffer();
+        bool partial = viewportData->redrawDamaged;
 
-                    // Apply scissor/clipping rectangle
-                    slag::Rectangle scissor;
-                    scissor.offset.x = (int32_t)(clip_min.x);
-                    scissor.offset.y = (int32_t)(clip_min.y);
-                    scissor.extent.width = (uint32_t)(clip_max.x - clip_min.x);
-                    scissor.extent.height = (uint32_t)(clip_max.y - clip_min.y);
-                    commandBuffer->setScissors(scissor);
+        commandBuffer->begin();
+        commandBuffer->bindDescriptorPool(rendererData->descriptorPool);
+        ImGui_Slag_RasterizeWindowCache(viewportData,viewport->DrawData,commandBuffer);
+        //a partial redraw builds on what's already in the back buffer, so it has to be kept
+        commandBuffer->insertBarrier(
+                {.texture=renderBuffer,
+                 .oldLayout=partial ? slag::Texture::PRESENT : slag::Texture::UNDEFINED,
+                 .newLayout=slag::Texture::RENDER_TARGET,
+                 .accessBefore=slag::BarrierAccessFlags::NONE,
+                 .accessAfter=slag::BarrierAccessFlags::COLOR_ATTACHMENT_WRITE,
+                 .syncBefore = slag::PipelineStageFlags::NONE,
+                 .syncAfter = slag::PipelineStageFlags::COLOR_ATTACHMENT
+                }
+         );
 
+        slag::Attachment attachment{.texture=renderBuffer,.layout=slag::Texture::RENDER_TARGET,.clearOnLoad=!partial,.clear={.color={0.0f,0.0f,0.0f,1.0f}}};
+        commandBuffer->beginRendering(&attachment,1, nullptr,{.offset={0,0},.extent={renderBuffer->width(),renderBuffer->height()}});
 
-                    // Bind DescriptorSet with font or user texture
-                    auto descriptorBundle = (slag::DescriptorBundle*)pcmd->GetTexID();
-                    commandBuffer->bindGraphicsDescriptorBundle(shader,0,*descriptorBundle);
-                    // Draw
-                    commandBuffer->drawIndexed(pcmd->ElemCount,1,pcmd->IdxOffset+indexDrawOffset,pcmd->VtxOffset+vertexDrawOffset,0);
-                }
-            }
-            indexDrawOffset += draw_list->IdxBuffer.Size;
-            vertexDrawOffset += draw_list->VtxBuffer.Size;
+        if(partial)
+        {
+            //draw the damaged areas' clear before anything else
+            ImDrawData* drawData = viewport->DrawData;
+            ImDrawList* clearList = viewportData->clearList;
+            drawData->CmdLists.push_front(clearList);
+            drawData->CmdListsCount++;
+            drawData->TotalVtxCount += clearList->VtxBuffer.Size;
+            drawData->TotalIdxCount += clearList->IdxBuffer.Size;
+            viewportData->partialRedraw = true;
+            ImGui_ImplSlag_RenderDrawData(drawData,commandBuffer);
+            viewportData->partialRedraw = false;
+            drawData->CmdLists.erase(drawData->CmdLists.Data);
+            drawData->CmdListsCount--;
+            drawData->TotalVtxCount -= clearList->VtxBuffer.Size;
+            drawData->TotalIdxCount -= clearList->IdxBuffer.Size;
         }
+        else
+        {
+            ImGui_ImplSlag_RenderDrawData(viewport->DrawData,commandBuffer);
+        }
+        commandBuffer->endRendering();
+        commandBuffer->insertBarrier(
+                {.texture=frame->backBuffer(),
+                        .oldLayout=slag::Texture::RENDER_TARGET,
+                        .newLayout=slag::Texture::PRESENT,
+                        .accessBefore=slag::BarrierAccessFlags::COLOR_ATTACHMENT_WRITE,
+                        .accessAfter=slag::BarrierAccessFlags::NONE,
+                        .syncBefore = slag::PipelineStageFlags::COLOR_ATTACHMENT,
+                        .syncAfter = slag::PipelineStageFlags::NONE
+                }
+        );
 
-        platform_io.Renderer_RenderState = nullptr;
-
-        slag::Rectangle scissor = { { 0, 0 }, { frameBufferWidth, frameBufferHeight } };
-        commandBuffer->setScissors(scissor);
+        commandBuffer->end();
+        return true;
+    }
+    return false;
+}
+void ImGui_Slag_RecordWindowJob(uint32_t jobIndex, void* jobData)
+{
+    auto viewports = static_cast<ImVector<ImGuiViewport*>*>(jobData);
+#ifdef GImGui
+    //GImGui is thread local, so the worker records against the context the main thread is blocked in
+    ImGuiContext* workerContext = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(IMGUI_IMPL_SLAG_RECORDING_CONTEXT);
+#endif
+    IMGUI_IMPL_SLAG_RECORDING_IN_PARALLEL = true;
+    ImGui_Slag_RecordWindow((*viewports)[jobIndex]);
+    IMGUI_IMPL_SLAG_RECORDING_IN_PARALLEL = false;
+#ifdef GImGui
+    ImGui::SetCurrentContext(workerContext);
+#endif
+}
+void ImGui_Slag_SubmitWindow(ImGuiViewport* viewport)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("submit window");
+    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+    auto frame = viewportData->swapchain->currentFrame();
+    auto commandBuffer = static_cast<ImGuiFrameResources*>(frame->resources)->commandBuffer;
+    slag::SlagLib::graphicsCard()->graphicsQueue()->submit(&commandBuffer, 1, nullptr, 0, nullptr, 0, frame);
+}
+void ImGui_Slag_RenderWindow(ImGuiViewport* viewport, void* unknown)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_Slag_RenderWindow");
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(ImGui::GetIO().BackendRendererUserData);
+    if(ImGui_Slag_ViewportUnchanged(rendererData,viewport))
+    {
+        return;
+    }
+    ImGui_Slag_PrepareWindow(rendererData,viewport);
+    if(ImGui_Slag_RecordWindow(viewport))
+    {
+        ImGui_Slag_SubmitWindow(viewport);
+    }
+}
+void ImGui_Slag_SwapBuffers(ImGuiViewport* viewport, void* unknown)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_Slag_SwapBuffers");
+    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+    //nothing was presented, keep the frame we already have
+    if(viewportData->unchanged && viewportData->hashedImGuiFrame == ImGui::GetFrameCount())
+    {
+        return;
+    }
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("swapchain next");
+    viewportData->swapchain->next();
+}
+void ImGui_Slag_ReleaseTextureEntry(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_TextureEntry* entry)
+{
+    rendererData->textureIds.erase(entry->id);
+    if(entry->bundle)
+    {
+        delete entry->bundle;
+    }
+    else if(rendererData->bindless)
+    {
+        rendererData->bindlessTextures[entry->bindlessSlot] = {nullptr,nullptr};
+        rendererData->freeBindlessSlots.push_back(entry->bindlessSlot);
+        rendererData->bindlessSlotVersions[entry->bindlessSlot] = ++rendererData->bindlessVersion;
+    }
+    if(entry->destroyTexture)
+    {
+        delete entry->texture;
+    }
+    delete entry;
+}
+slag::ShaderPipeline* ImGui_Slag_CreateShaderPipeline(const unsigned char* vertexShader, size_t vertexShaderLength, const unsigned char* fragmentShader, size_t fragmentShaderLength, slag::Pixels::Format backBufferFormat, bool compactVertices = false)
+{
+    slag::VertexDescription vertexDescription(1);
+    if(compactVertices)
+    {
+        vertexDescription.add(slag::GraphicsTypes::UNSIGNED_INTEGER, offsetof(ImGui_ImplSlag_CompactVert,pos),0);
+        vertexDescription.add(slag::GraphicsTypes::UNSIGNED_INTEGER, offsetof(ImGui_ImplSlag_CompactVert,uv),0);
+        vertexDescription.add(slag::GraphicsTypes::UNSIGNED_INTEGER, offsetof(ImGui_ImplSlag_CompactVert,col),0);
+    }
+    else
+    {
+        vertexDescription.add(slag::GraphicsTypes::VECTOR2, offsetof(ImDrawVert,pos),0);
+        vertexDescription.add(slag::GraphicsTypes::VECTOR2, offsetof(ImDrawVert,uv),0);
+        vertexDescription.add(slag::GraphicsTypes::UNSIGNED_INTEGER, offsetof(ImDrawVert,col),0);
     }
 
+    slag::FrameBufferDescription frameBufferDescription;
+    frameBufferDescription.addColorTarget(backBufferFormat);
+
+    slag::ShaderModule modules[2]
+    {
+        slag::ShaderModule (slag::ShaderStageFlags::VERTEX, (void*) vertexShader, vertexShaderLength),
+        slag::ShaderModule (slag::ShaderStageFlags::FRAGMENT, (void*) fragmentShader, fragmentShaderLength)
+    };
+    slag::ShaderProperties shaderProperties;
+    return slag::ShaderPipeline::newShaderPipeline(modules,2, nullptr,0,shaderProperties,&vertexDescription,frameBufferDescription);
+}
+//where each ImGui_ImplSlag_Pipeline is kept once it's made
+slag::ShaderPipeline*& ImGui_Slag_PipelineSlot(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_Pipeline pipeline)
+{
+    switch(pipeline)
+    {
+        case ImGui_ImplSlag_Pipeline_Compact:
+            return rendererData->compactShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_Bindless:
+            return rendererData->bindlessShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_CompactBindless:
+            return rendererData->compactBindlessShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_Alpha:
+            return rendererData->alphaShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_CompactAlpha:
+            return rendererData->compactAlphaShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_Grayscale:
+            return rendererData->grayscaleShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_CompactGrayscale:
+            return rendererData->compactGrayscaleShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_Sdf:
+            return rendererData->sdfShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_CompactSdf:
+            return rendererData->compactSdfShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_BindlessSdf:
+            return rendererData->bindlessSdfShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_CompactBindlessSdf:
+            return rendererData->compactBindlessSdfShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_Composite:
+            return rendererData->compositeShaderPipeline;
+        case ImGui_ImplSlag_Pipeline_CompactComposite:
+            return rendererData->compactCompositeShaderPipeline;
+        default:
+            return rendererData->shaderPipeline;
+    }
+}
+slag::ShaderPipeline* ImGui_Slag_CreatePipeline(ImGui_ImplSlag_Pipeline pipeline, slag::Pixels::Format backBufferFormat)
+{
+    const auto& shaders = IMGUI_IMPL_SLAG_PIPELINE_SHADERS[pipeline];
+    return ImGui_Slag_CreateShaderPipeline(shaders.vertexShader,shaders.vertexShaderLength,shaders.fragmentShader,shaders.fragmentShaderLength,backBufferFormat,shaders.compactVertices);
+}
+void ImGui_Slag_PrewarmPipelinesJob(ImGui_ImplSlag_Data* rendererData)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("prewarm pipelines");
+    for(int i=0; i<ImGui_ImplSlag_Pipeline_COUNT; i++)
+    {
+        if(rendererData->prewarmPipelines & (1u<<i))
+        {
+            slag::ShaderPipeline* pipeline = ImGui_Slag_CreatePipeline((ImGui_ImplSlag_Pipeline)i,rendererData->backBufferFormat);
+            std::lock_guard<std::mutex> lock(rendererData->pipelineMutex);
+            rendererData->prewarmed[i] = pipeline;
+            rendererData->prewarmedPipelines |= 1u<<i;
+            rendererData->pipelineCreated.notify_all();
+        }
+    }
+}
+//gets a pipeline, making it if this is its first use. Only the first use has to be on the main thread, before any workers record with it
+slag::ShaderPipeline* ImGui_Slag_Pipeline(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_Pipeline pipeline)
+{
+    slag::ShaderPipeline*& slot = ImGui_Slag_PipelineSlot(rendererData,pipeline);
+    if(slot == nullptr)
+    {
+        if(rendererData->prewarmPipelines & (1u<<pipeline))
+        {
+            //already being made in the background, waiting on that is never slower than starting over
+            std::unique_lock<std::mutex> lock(rendererData->pipelineMutex);
+            rendererData->pipelineCreated.wait(lock,[&](){return (rendererData->prewarmedPipelines & (1u<<pipeline)) != 0;});
+            slot = rendererData->prewarmed[pipeline];
+            rendererData->prewarmed[pipeline] = nullptr;
+        }
+        else
+        {
+            slot = ImGui_Slag_CreatePipeline(pipeline,rendererData->backBufferFormat);
+        }
+    }
+    return slot;
+}
+//binds a pipeline to draw with and marks it used for ImGui_ImplSlag_GetPipelineCacheData
+void ImGui_Slag_BindPipeline(ImGui_ImplSlag_Data* rendererData, slag::CommandBuffer* commandBuffer, slag::ShaderPipeline* pipeline)
+{
+    for(int i=0; i<ImGui_ImplSlag_Pipeline_COUNT; i++)
+    {
+        if(ImGui_Slag_PipelineSlot(rendererData,(ImGui_ImplSlag_Pipeline)i) == pipeline)
+        {
+            rendererData->usedPipelines.fetch_or(1u<<i,std::memory_order_relaxed);
+            break;
+        }
+    }
+    commandBuffer->bindGraphicsShader(pipeline);
+}
+slag::ShaderPipeline* ImGui_Slag_CurrentShaderPipeline(ImGui_ImplSlag_Data* rendererData)
+{
+    if(rendererData->compactVertices)
+    {
+        return ImGui_Slag_Pipeline(rendererData,rendererData->bindless ? ImGui_ImplSlag_Pipeline_CompactBindless : ImGui_ImplSlag_Pipeline_Compact);
+    }
+    return rendererData->bindless ? rendererData->bindlessShaderPipeline : rendererData->shaderPipeline;
+}
+//pipeline raw descriptor bundles are drawn with in bindless mode, the current one otherwise
+slag::ShaderPipeline* ImGui_Slag_RegularShaderPipeline(ImGui_ImplSlag_Data* rendererData)
+{
+    return rendererData->compactVertices ? ImGui_Slag_Pipeline(rendererData,ImGui_ImplSlag_Pipeline_Compact) : rendererData->shaderPipeline;
+}
+//makes the pipelines draws can switch to with the current vertex format: for the single channel textures registered, cached windows and sdf text
+//called on the main thread whenever one of those or the format changes, rather than on first draw, as viewports can be recorded on several threads at once
+void ImGui_Slag_CreateFormatPipelines(ImGui_ImplSlag_Data* rendererData)
+{
+    bool compact = rendererData->compactVertices;
+    if(!rendererData->bindless)
+    {
+        //bindless draws single channel textures with the array's own pipeline
+        if(rendererData->textureChannels & (1u<<ImGui_ImplSlag_TextureChannels_Alpha))
+        {
+            ImGui_Slag_Pipeline(rendererData,compact ? ImGui_ImplSlag_Pipeline_CompactAlpha : ImGui_ImplSlag_Pipeline_Alpha);
+        }
+        if(rendererData->textureChannels & (1u<<ImGui_ImplSlag_TextureChannels_Grayscale))
+        {
+            ImGui_Slag_Pipeline(rendererData,compact ? ImGui_ImplSlag_Pipeline_CompactGrayscale : ImGui_ImplSlag_Pipeline_Grayscale);
+        }
+    }
+    if(rendererData->cacheWindows)
+    {
+        ImGui_Slag_Pipeline(rendererData,compact ? ImGui_ImplSlag_Pipeline_CompactComposite : ImGui_ImplSlag_Pipeline_Composite);
+    }
+    if(rendererData->sdfText)
+    {
+        if(rendererData->bindless)
+        {
+            ImGui_Slag_Pipeline(rendererData,compact ? ImGui_ImplSlag_Pipeline_CompactBindlessSdf : ImGui_ImplSlag_Pipeline_BindlessSdf);
+        }
+        else
+        {
+            ImGui_Slag_Pipeline(rendererData,compact ? ImGui_ImplSlag_Pipeline_CompactSdf : ImGui_ImplSlag_Pipeline_Sdf);
+        }
+    }
+}
+//pipeline that draws textures with the given channels, rgbaPipeline is the one the draw data was set up with
+slag::ShaderPipeline* ImGui_Slag_ChannelsShaderPipeline(ImGui_ImplSlag_Data* rendererData, slag::ShaderPipeline* rgbaPipeline, ImGui_ImplSlag_TextureChannels channels)
+{
+    switch(channels)
+    {
+        case ImGui_ImplSlag_TextureChannels_Alpha:
+            return rendererData->compactVertices ? rendererData->compactAlphaShaderPipeline : rendererData->alphaShaderPipeline;
+        case ImGui_ImplSlag_TextureChannels_Grayscale:
+            return rendererData->compactVertices ? rendererData->compactGrayscaleShaderPipeline : rendererData->grayscaleShaderPipeline;
+        default:
+            return rgbaPipeline;
+    }
+}
+void ImGui_Slag_WriteSdfGlyphs(ImFontAtlas* atlas, unsigned char* pixels, int atlasWidth, int texelSize)
+{
+    for(auto& sdfGlyph: IMGUI_IMPL_SLAG_SDF_GLYPHS)
+    {
+        const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(sdfGlyph.rect);
+        for(int y=0; y<sdfGlyph.height; y++)
+        {
+            for(int x=0; x<sdfGlyph.width; x++)
+            {
+                //distance goes where baked glyphs keep their coverage
+                unsigned char* pixel = pixels+((rect->Y+y)*atlasWidth+rect->X+x)*texelSize;
+                pixel[texelSize-1] = sdfGlyph.distances[y*sdfGlyph.width+x];
+                if(texelSize == 4)
+                {
+                    pixel[0] = pixel[1] = pixel[2] = 255;
+                }
+            }
+        }
+        stbtt_FreeSDF(sdfGlyph.distances,nullptr);
+    }
+    IMGUI_IMPL_SLAG_SDF_GLYPHS.clear();
+}
+void ImGui_Slag_SetupGlyphCache(ImGui_ImplSlag_Data* rendererData, ImFontAtlas* atlas, int customRect)
+{
+    const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(customRect);
+    rendererData->glyphCacheX = rect->X;
+    rendererData->glyphCacheY = rect->Y;
+    std::vector<ImFontConfig*> configs;
+    for(auto lazyFont: IMGUI_IMPL_SLAG_LAZY_FONTS)
+    {
+        ImFontConfig* config = nullptr;
+        for(int i=0; i<atlas->ConfigData.Size && !config; i++)
+        {
+            if(atlas->ConfigData[i].FontData == lazyFont->fontData)
+            {
+                config = &atlas->ConfigData[i];
+            }
+        }
+        assert(config && "lazy font was removed from the font atlas");
+        configs.push_back(config);
+        auto data = static_cast<const unsigned char*>(lazyFont->fontData);
+        stbtt_InitFont(&lazyFont->fontInfo,data,stbtt_GetFontOffsetForIndex(data,config->FontNo));
+        lazyFont->scale = stbtt_ScaleForPixelHeight(&lazyFont->fontInfo,config->SizePixels);
+        //one pixel of padding keeps neighbouring cells out of the filtering
+        int x0,y0,x1,y1;
+        stbtt_GetFontBoundingBox(&lazyFont->fontInfo,&x0,&y0,&x1,&y1);
+        rendererData->glyphCellWidth = std::max(rendererData->glyphCellWidth,(uint32_t)std::ceil((x1-x0)*lazyFont->scale)+2);
+        rendererData->glyphCellHeight = std::max(rendererData->glyphCellHeight,(uint32_t)std::ceil((y1-y0)*lazyFont->scale)+2);
+    }
+    rendererData->glyphCellWidth = std::min(rendererData->glyphCellWidth,(uint32_t)IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE);
+    rendererData->glyphCellHeight = std::min(rendererData->glyphCellHeight,(uint32_t)IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE);
+    rendererData->glyphCellColumns = IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE/rendererData->glyphCellWidth;
+    rendererData->glyphCells.resize(rendererData->glyphCellColumns*(IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE/rendererData->glyphCellHeight));
+
+    //every lazy glyph gets its real metrics now so layout doesn't change once it's rasterized, its uvs are negative and hold its index until it's resident
+    for(size_t i=0; i<IMGUI_IMPL_SLAG_LAZY_FONTS.size(); i++)
+    {
+        auto lazyFont = IMGUI_IMPL_SLAG_LAZY_FONTS[i];
+        ImFontConfig* config = configs[i];
+        ImFont* font = config->DstFont;
+        const float offsetX = config->GlyphOffset.x;
+        const float offsetY = config->GlyphOffset.y + (float)(int)(font->Ascent + 0.5f);
+        for(size_t range=0; range+1<lazyFont->lazyGlyphRanges.size(); range+=2)
+        {
+            for(unsigned int codepoint = lazyFont->lazyGlyphRanges[range]; codepoint <= lazyFont->lazyGlyphRanges[range+1]; codepoint++)
+            {
+                if(font->FindGlyphNoFallback((ImWchar)codepoint))
+                {
+                    continue;
+                }
+                int fontGlyph = stbtt_FindGlyphIndex(&lazyFont->fontInfo,(int)codepoint);
+                if(fontGlyph == 0)
+                {
+                    continue;
+                }
+                int advance, leftSideBearing, x0, y0, x1, y1;
+                stbtt_GetGlyphHMetrics(&lazyFont->fontInfo,fontGlyph,&advance,&leftSideBearing);
+                stbtt_GetGlyphBitmapBox(&lazyFont->fontInfo,fontGlyph,lazyFont->scale,lazyFont->scale,&x0,&y0,&x1,&y1);
+                //clamped the same way as when it's rasterized, so the box matches the uvs of its cell
+                x1 = x0+std::min(x1-x0,(int)rendererData->glyphCellWidth-1);
+                y1 = y0+std::min(y1-y0,(int)rendererData->glyphCellHeight-1);
+                float placeholder = -(float)(rendererData->lazyGlyphs.size()+1);
+                font->AddGlyph(config,(ImWchar)codepoint,x0+offsetX,y0+offsetY,x1+offsetX,y1+offsetY,placeholder,placeholder,placeholder,placeholder,advance*lazyFont->scale);
+                ImGui_ImplSlag_LazyGlyph lazyGlyph;
+                lazyGlyph.font = font;
+                lazyGlyph.glyph = font->Glyphs.Size-1;
+                lazyGlyph.fontGlyph = fontGlyph;
+                lazyGlyph.lazyFont = (int)i;
+                rendererData->lazyGlyphs.push_back(lazyGlyph);
+            }
+        }
+        font->BuildLookupTable();
+    }
+}
+ImGui_ImplSlag_MappedFile* ImGui_Slag_MapFile(const std::string& path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if(GetFileSizeEx(file,&size) && size.QuadPart > 0)
+    {
+        mapping = CreateFileMappingA(file,nullptr,PAGE_READONLY,0,0,nullptr);
+    }
+    void* data = mapping ? MapViewOfFile(mapping,FILE_MAP_READ,0,0,0) : nullptr;
+    if(data == nullptr)
+    {
+        if(mapping)
+        {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return nullptr;
+    }
+    auto mapped = new ImGui_ImplSlag_MappedFile();
+    mapped->data = static_cast<const unsigned char*>(data);
+    mapped->size = (size_t)size.QuadPart;
+    mapped->file = file;
+    mapped->mapping = mapping;
+    return mapped;
+#else
+    int file = open(path.c_str(),O_RDONLY);
+    if(file == -1)
+    {
+        return nullptr;
+    }
+    struct stat status;
+    void* data = MAP_FAILED;
+    if(fstat(file,&status) == 0 && status.st_size > 0)
+    {
+        data = mmap(nullptr,(size_t)status.st_size,PROT_READ,MAP_PRIVATE,file,0);
+    }
+    //the mapping keeps the file alive on its own
+    close(file);
+    if(data == MAP_FAILED)
+    {
+        return nullptr;
+    }
+    auto mapped = new ImGui_ImplSlag_MappedFile();
+    mapped->data = static_cast<const unsigned char*>(data);
+    mapped->size = (size_t)status.st_size;
+    return mapped;
+#endif
+}
+void ImGui_Slag_UnmapFile(ImGui_ImplSlag_MappedFile* mapped)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(mapped->data);
+    CloseHandle(mapped->mapping);
+    CloseHandle(mapped->file);
+#else
+    munmap(const_cast<unsigned char*>(mapped->data),mapped->size);
+#endif
+    delete mapped;
+}
+//identifies everything that goes into building atlas, so a cached build is only used for the same fonts, sizes, ranges and config
+uint64_t ImGui_Slag_FontAtlasKey(ImFontAtlas* atlas)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const int32_t layout[] = {IMGUI_IMPL_SLAG_FONT_CACHE_VERSION,IMGUI_VERSION_NUM,(int32_t)sizeof(ImWchar),(int32_t)sizeof(ImFontGlyph),IMGUI_IMPL_SLAG_SDF_SPREAD,atlas->FontBuilderIO != nullptr};
+    hash = ImGui_Slag_HashBytes(layout,sizeof(layout),hash);
+    const int32_t atlasInputs[] = {atlas->Flags,atlas->TexDesiredWidth,atlas->TexGlyphPadding,(int32_t)atlas->FontBuilderFlags,atlas->Fonts.Size,atlas->PackIdMouseCursors,atlas->PackIdLines};
+    hash = ImGui_Slag_HashBytes(atlasInputs,sizeof(atlasInputs),hash);
+    for(const ImFontConfig& config: atlas->ConfigData)
+    {
+        hash = ImGui_Slag_HashBytes(config.FontData,(size_t)config.FontDataSize,hash);
+        const int32_t ints[] = {config.FontNo,config.OversampleH,config.OversampleV,config.PixelSnapH,config.MergeMode,(int32_t)config.FontBuilderFlags,(int32_t)config.EllipsisChar,atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(),atlas->Fonts.end(),config.DstFont))};
+        hash = ImGui_Slag_HashBytes(ints,sizeof(ints),hash);
+        const float floats[] = {config.SizePixels,config.GlyphExtraSpacing.x,config.GlyphExtraSpacing.y,config.GlyphOffset.x,config.GlyphOffset.y,config.GlyphMinAdvanceX,config.GlyphMaxAdvanceX,config.RasterizerMultiply,config.RasterizerDensity};
+        hash = ImGui_Slag_HashBytes(floats,sizeof(floats),hash);
+        //a null range is the default latin range
+        const ImWchar* ranges = config.GlyphRanges ? config.GlyphRanges : atlas->GetGlyphRangesDefault();
+        size_t rangeCount = 0;
+        while(ranges[rangeCount*2] != 0)
+        {
+            rangeCount++;
+        }
+        hash = ImGui_Slag_HashBytes(ranges,rangeCount*2*sizeof(ImWchar),hash);
+    }
+    for(const ImFontAtlasCustomRect& rect: atlas->CustomRects)
+    {
+        const int32_t ints[] = {rect.Width,rect.Height,(int32_t)rect.GlyphID,(int32_t)rect.GlyphColored,rect.Font ? atlas->Fonts.index_from_ptr(std::find(atlas->Fonts.begin(),atlas->Fonts.end(),rect.Font)) : -1};
+        hash = ImGui_Slag_HashBytes(ints,sizeof(ints),hash);
+        const float floats[] = {rect.GlyphAdvanceX,rect.GlyphOffset.x,rect.GlyphOffset.y};
+        hash = ImGui_Slag_HashBytes(floats,sizeof(floats),hash);
+    }
+    return hash;
+}
+std::string ImGui_Slag_FontCachePath(uint64_t key)
+{
+    char name[64];
+    snprintf(name,sizeof(name),"/imgui_font_atlas_%016llx.bin",(unsigned long long)key);
+    return IMGUI_IMPL_SLAG_FONT_CACHE_DIRECTORY + name;
+}
+//restores what building atlas would have produced from a cache file, the returned pixels point into the mapping, which is kept in rendererData until they're uploaded
+unsigned char* ImGui_Slag_LoadFontAtlas(ImGui_ImplSlag_Data* rendererData, ImFontAtlas* atlas, uint64_t key, int& width, int& height, bool& singleChannel)
+{
+    ImGui_ImplSlag_MappedFile* file = ImGui_Slag_MapFile(ImGui_Slag_FontCachePath(key));
+    if(file == nullptr)
+    {
+        return nullptr;
+    }
+    size_t offset = 0;
+    auto read = [&](void* destination, size_t size)
+    {
+        if(size > file->size-offset)
+        {
+            return false;
+        }
+        memcpy(destination,file->data+offset,size);
+        offset += size;
+        return true;
+    };
+    ImGui_ImplSlag_FontCacheHeader header;
+    bool valid = read(&header,sizeof(header))
+        && header.magic == IM_COL32('I','M','F','C') && header.version == IMGUI_IMPL_SLAG_FONT_CACHE_VERSION && header.key == key
+        && header.fontCount == atlas->Fonts.Size && header.customRectCount >= atlas->CustomRects.Size
+        && (header.texelSize == 1 || header.texelSize == 4) && header.width > 0 && header.height > 0
+        && header.pixelsOffset <= file->size && file->size-header.pixelsOffset >= (uint64_t)header.width*header.height*header.texelSize;
+    //fonts are only touched once the whole file has been read, so a bad file just falls back to building
+    std::vector<ImGui_ImplSlag_FontCacheFont> fonts(valid ? header.fontCount : 0);
+    std::vector<size_t> glyphTables(fonts.size());
+    for(size_t i=0; valid && i<fonts.size(); i++)
+    {
+        auto& font = fonts[i];
+        valid = read(&font,sizeof(font)) && font.glyphCount >= 0 && font.indexAdvanceCount >= 0 && font.indexLookupCount >= 0
+            && (font.glyphCount == 0 ? font.fallbackGlyph == -1 : font.fallbackGlyph >= 0 && font.fallbackGlyph < font.glyphCount);
+        glyphTables[i] = offset;
+        size_t lookupOffset = (size_t)font.glyphCount*sizeof(ImFontGlyph)+(size_t)font.indexAdvanceCount*sizeof(float);
+        size_t tableSize = lookupOffset+(size_t)font.indexLookupCount*sizeof(ImWchar);
+        valid = valid && tableSize <= file->size-offset;
+        //ImFont::FindGlyph indexes Glyphs with lookup entries unchecked, so each has to be a glyph or the no glyph marker
+        for(int j=0; valid && j<font.indexLookupCount; j++)
+        {
+            ImWchar glyph;
+            memcpy(&glyph,file->data+offset+lookupOffset+j*sizeof(ImWchar),sizeof(ImWchar));
+            valid = glyph == (ImWchar)-1 || (int)glyph < font.glyphCount;
+        }
+        offset += valid ? tableSize : 0;
+    }
+    std::vector<ImFontAtlasCustomRect> rects(valid ? header.customRectCount : 0);
+    for(size_t i=0; valid && i<rects.size(); i++)
+    {
+        unsigned short geometry[4];
+        valid = read(geometry,sizeof(geometry));
+        rects[i].X = geometry[0];
+        rects[i].Y = geometry[1];
+        rects[i].Width = geometry[2];
+        rects[i].Height = geometry[3];
+    }
+    if(!valid)
+    {
+        ImGui_Slag_UnmapFile(file);
+        return nullptr;
+    }
+
+    for(int i=0; i<atlas->Fonts.Size; i++)
+    {
+        ImFont* font = atlas->Fonts[i];
+        const auto& cached = fonts[i];
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        font->FontSize = cached.fontSize;
+        font->Ascent = cached.ascent;
+        font->Descent = cached.descent;
+        font->FallbackAdvanceX = cached.fallbackAdvanceX;
+        font->EllipsisWidth = cached.ellipsisWidth;
+        font->EllipsisCharStep = cached.ellipsisCharStep;
+        font->MetricsTotalSurface = cached.metricsTotalSurface;
+        font->EllipsisChar = (ImWchar)cached.ellipsisChar;
+        font->FallbackChar = (ImWchar)cached.fallbackChar;
+        font->EllipsisCharCount = (short)cached.ellipsisCharCount;
+        memcpy(font->Used4kPagesMap,cached.used4kPagesMap,sizeof(font->Used4kPagesMap));
+        offset = glyphTables[i];
+        font->Glyphs.resize(cached.glyphCount);
+        read(font->Glyphs.Data,font->Glyphs.size_in_bytes());
+        font->IndexAdvanceX.resize(cached.indexAdvanceCount);
+        read(font->IndexAdvanceX.Data,font->IndexAdvanceX.size_in_bytes());
+        font->IndexLookup.resize(cached.indexLookupCount);
+        read(font->IndexLookup.Data,font->IndexLookup.size_in_bytes());
+        font->FallbackGlyph = cached.fallbackGlyph >= 0 ? &font->Glyphs[cached.fallbackGlyph] : nullptr;
+        font->DirtyLookupTables = false;
+    }
+    //the build registers the mouse cursor and line rects itself, so there can be more rects than before it
+    for(int i=0; i<(int)rects.size(); i++)
+    {
+        if(i == atlas->CustomRects.Size)
+        {
+            atlas->CustomRects.push_back(ImFontAtlasCustomRect());
+            atlas->CustomRects[i].Width = rects[i].Width;
+            atlas->CustomRects[i].Height = rects[i].Height;
+        }
+        atlas->CustomRects[i].X = rects[i].X;
+        atlas->CustomRects[i].Y = rects[i].Y;
+    }
+    atlas->PackIdMouseCursors = header.packIdMouseCursors;
+    atlas->PackIdLines = header.packIdLines;
+    atlas->TexWidth = header.width;
+    atlas->TexHeight = header.height;
+    atlas->TexUvScale = ImVec2(1.0f/header.width,1.0f/header.height);
+    atlas->TexUvWhitePixel = header.texUvWhitePixel;
+    memcpy(atlas->TexUvLines,header.texUvLines,sizeof(atlas->TexUvLines));
+    atlas->TexReady = true;
+    width = header.width;
+    height = header.height;
+    singleChannel = header.texelSize == 1;
+    rendererData->fontCacheFile = file;
+    return const_cast<unsigned char*>(file->data+header.pixelsOffset);
+}
+//writes a freshly built atlas to its cache file, through a temporary file so other processes never map a partial one
+void ImGui_Slag_SaveFontAtlas(ImFontAtlas* atlas, uint64_t key, const unsigned char* pixels, int texelSize)
+{
+    std::string path = ImGui_Slag_FontCachePath(key);
+#ifdef _WIN32
+    std::string temporaryPath = path + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+#else
+    std::string temporaryPath = path + "." + std::to_string(getpid()) + ".tmp";
+#endif
+    FILE* file = fopen(temporaryPath.c_str(),"wb");
+    if(file == nullptr)
+    {
+        return;
+    }
+    ImGui_ImplSlag_FontCacheHeader header;
+    memset(static_cast<void*>(&header),0,sizeof(header));
+    header.magic = IM_COL32('I','M','F','C');
+    header.version = IMGUI_IMPL_SLAG_FONT_CACHE_VERSION;
+    header.key = key;
+    header.width = atlas->TexWidth;
+    header.height = atlas->TexHeight;
+    header.texelSize = texelSize;
+    header.fontCount = atlas->Fonts.Size;
+    header.customRectCount = atlas->CustomRects.Size;
+    header.packIdMouseCursors = atlas->PackIdMouseCursors;
+    header.packIdLines = atlas->PackIdLines;
+    header.texUvWhitePixel = atlas->TexUvWhitePixel;
+    memcpy(header.texUvLines,atlas->TexUvLines,sizeof(header.texUvLines));
+    header.pixelsOffset = sizeof(header);
+    for(ImFont* font: atlas->Fonts)
+    {
+        header.pixelsOffset += sizeof(ImGui_ImplSlag_FontCacheFont)+font->Glyphs.size_in_bytes()+font->IndexAdvanceX.size_in_bytes()+font->IndexLookup.size_in_bytes();
+    }
+    header.pixelsOffset += atlas->CustomRects.Size*4*sizeof(unsigned short);
+    //pixels start aligned, so they can be copied straight out of the mapping
+    uint64_t padding = (16-header.pixelsOffset%16)%16;
+    header.pixelsOffset += padding;
+    bool written = fwrite(&header,sizeof(header),1,file) == 1;
+    for(ImFont* font: atlas->Fonts)
+    {
+        ImGui_ImplSlag_FontCacheFont cached;
+        memset(&cached,0,sizeof(cached));
+        cached.fontSize = font->FontSize;
+        cached.ascent = font->Ascent;
+        cached.descent = font->Descent;
+        cached.fallbackAdvanceX = font->FallbackAdvanceX;
+        cached.ellipsisWidth = font->EllipsisWidth;
+        cached.ellipsisCharStep = font->EllipsisCharStep;
+        cached.glyphCount = font->Glyphs.Size;
+        cached.indexAdvanceCount = font->IndexAdvanceX.Size;
+        cached.indexLookupCount = font->IndexLookup.Size;
+        cached.fallbackGlyph = font->FallbackGlyph ? font->Glyphs.index_from_ptr(font->FallbackGlyph) : -1;
+        cached.metricsTotalSurface = font->MetricsTotalSurface;
+        cached.ellipsisChar = font->EllipsisChar;
+        cached.fallbackChar = font->FallbackChar;
+        cached.ellipsisCharCount = font->EllipsisCharCount;
+        memcpy(cached.used4kPagesMap,font->Used4kPagesMap,sizeof(cached.used4kPagesMap));
+        written = written && fwrite(&cached,sizeof(cached),1,file) == 1;
+        written = written && fwrite(font->Glyphs.Data,1,font->Glyphs.size_in_bytes(),file) == (size_t)font->Glyphs.size_in_bytes();
+        written = written && fwrite(font->IndexAdvanceX.Data,1,font->IndexAdvanceX.size_in_bytes(),file) == (size_t)font->IndexAdvanceX.size_in_bytes();
+        written = written && fwrite(font->IndexLookup.Data,1,font->IndexLookup.size_in_bytes(),file) == (size_t)font->IndexLookup.size_in_bytes();
+    }
+    for(const ImFontAtlasCustomRect& rect: atlas->CustomRects)
+    {
+        const unsigned short geometry[4] = {rect.X,rect.Y,rect.Width,rect.Height};
+        written = written && fwrite(geometry,sizeof(geometry),1,file) == 1;
+    }
+    const unsigned char zeros[16] = {};
+    written = written && fwrite(zeros,1,padding,file) == padding;
+    size_t pixelsSize = (size_t)atlas->TexWidth*atlas->TexHeight*texelSize;
+    written = written && fwrite(pixels,1,pixelsSize,file) == pixelsSize;
+    written = fclose(file) == 0 && written;
+#ifdef _WIN32
+    //rename won't replace an existing file here, another process may have finished the same cache first
+    if(written && !MoveFileExA(temporaryPath.c_str(),path.c_str(),MOVEFILE_REPLACE_EXISTING))
+#else
+    if(written && rename(temporaryPath.c_str(),path.c_str()) != 0)
+#endif
+    {
+        written = false;
+    }
+    if(!written)
+    {
+        remove(temporaryPath.c_str());
+    }
+}
+void ImGui_Slag_ReleaseFontCache(ImGui_ImplSlag_Data* rendererData)
+{
+    if(rendererData->fontCacheFile)
+    {
+        ImGui_Slag_UnmapFile(rendererData->fontCacheFile);
+        rendererData->fontCacheFile = nullptr;
+    }
+}
+//builds atlas, along with the backend's lazy and sdf fonts when backendFonts is set, and returns its pixels. Only touches atlas and the backend's font state, so it can run on a worker thread
+//the stb_truetype builder's jobs, run through the backend's job system
+struct ImGui_ImplSlag_FontBuildJobs
+{
+    void (*job)(int jobIndex, void* jobData) = nullptr;
+    void* jobData = nullptr;
+};
+void ImGui_Slag_FontBuildJob(uint32_t jobIndex, void* jobData)
+{
+    auto jobs = static_cast<ImGui_ImplSlag_FontBuildJobs*>(jobData);
+    jobs->job((int)jobIndex,jobs->jobData);
+}
+//ImFontAtlas::BuilderParallelFor that hands glyph rasterization to the job system given to ImGui_ImplSlag_SetJobSystem, userData is the renderer data
+void ImGui_Slag_FontBuilderParallelFor(int jobCount, void (*job)(int jobIndex, void* jobData), void* jobData, void* userData)
+{
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(userData);
+    ImGui_ImplSlag_FontBuildJobs jobs{job,jobData};
+    rendererData->parallelFor((uint32_t)jobCount,ImGui_Slag_FontBuildJob,&jobs,rendererData->parallelForUserData);
+}
+unsigned char* ImGui_Slag_BuildFontAtlas(ImGui_ImplSlag_Data* rendererData, ImFontAtlas* atlas, bool backendFonts, int& width, int& height, bool& singleChannel)
+{
+    //the glyph cache is reserved before the atlas is built, so lazy fonts only bake their regular glyph ranges
+    int glyphCacheRect = -1;
+    if(backendFonts && !IMGUI_IMPL_SLAG_LAZY_FONTS.empty())
+    {
+        glyphCacheRect = atlas->AddCustomRectRegular(IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE,IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE);
+        atlas->TexDesiredWidth = std::max(atlas->TexDesiredWidth,IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE);
+        atlas->ClearTexData();
+    }
+    //an atlas the application already built has nothing left to save
+    bool cached = backendFonts && !IMGUI_IMPL_SLAG_FONT_CACHE_DIRECTORY.empty() && atlas->TexPixelsAlpha8 == nullptr && atlas->TexPixelsRGBA32 == nullptr;
+    uint64_t key = cached ? ImGui_Slag_FontAtlasKey(atlas) : 0;
+    unsigned char* pixels = cached ? ImGui_Slag_LoadFontAtlas(rendererData,atlas,key,width,height,singleChannel) : nullptr;
+    if(pixels)
+    {
+        //the cached pixels already have the distance fields in them
+        for(auto& sdfGlyph: IMGUI_IMPL_SLAG_SDF_GLYPHS)
+        {
+            stbtt_FreeSDF(sdfGlyph.distances,nullptr);
+        }
+        IMGUI_IMPL_SLAG_SDF_GLYPHS.clear();
+    }
+    else
+    {
+        //glyphs are rasterized on the job system too, unless the application gave the atlas its own. The hook is only set for this build, the renderer data doesn't outlive the backend
+        bool parallelBuild = rendererData->parallelFor != nullptr && atlas->BuilderParallelFor == nullptr;
+        if(parallelBuild)
+        {
+            atlas->BuilderParallelFor = ImGui_Slag_FontBuilderParallelFor;
+            atlas->BuilderParallelForUserData = rendererData;
+        }
+        //glyphs are only coverage, so the atlas is uploaded as R8 unless it has colored glyphs or the application already asked for rgba pixels
+        singleChannel = atlas->TexPixelsRGBA32 == nullptr;
+        if(singleChannel)
+        {
+            atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+            singleChannel = !atlas->TexPixelsUseColors;
+        }
+        if(!singleChannel)
+        {
+            atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+        }
+        if(parallelBuild)
+        {
+            atlas->BuilderParallelFor = nullptr;
+            atlas->BuilderParallelForUserData = nullptr;
+        }
+        if(backendFonts)
+        {
+            ImGui_Slag_WriteSdfGlyphs(atlas,pixels,width,singleChannel ? 1 : 4);
+        }
+        if(cached)
+        {
+            ImGui_Slag_SaveFontAtlas(atlas,key,pixels,singleChannel ? 1 : 4);
+        }
+    }
+    //placeholder glyphs are added after saving, they're only valid for this process' glyph cache
+    if(glyphCacheRect != -1)
+    {
+        ImGui_Slag_SetupGlyphCache(rendererData,atlas,glyphCacheRect);
+    }
+    return pixels;
+}
+void ImGui_Slag_BuildFontAtlasJob(ImGui_ImplSlag_Data* rendererData)
+{
+#ifdef GImGui
+    //GImGui is thread local, nothing the build allocates may report to a context another thread is using
+    ImGui::SetCurrentContext(nullptr);
+#endif
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("build font atlas");
+    rendererData->pendingFontPixels = ImGui_Slag_BuildFontAtlas(rendererData,rendererData->pendingFontAtlas,true,rendererData->pendingFontWidth,rendererData->pendingFontHeight,rendererData->pendingFontsSingleChannel);
+    rendererData->fontBuildFinished.store(true,std::memory_order_release);
+}
+//the atlas the application's fonts are in is built and on the gpu
+void ImGui_Slag_FontsReady(ImGui_ImplSlag_Data* rendererData, bool singleChannel)
+{
+    rendererData->fontsReady = true;
+    rendererData->singleChannelFonts = singleChannel;
+    if(!rendererData->lazyGlyphs.empty())
+    {
+        rendererData->glyphUploadBuffer = new ImGui_ImplSlag_RingBuffer(0,slag::Buffer::DATA_BUFFER,IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1);
+    }
+}
+
+bool ImGui_ImplSlag_Init(slag::Swapchain* mainSwapchain, slag::PlatformData platformData, void* (*extractNativeHandle)(ImGuiViewport* fromViewport), slag::Sampler* sampler, slag::Pixels::Format backBufferFormat, size_t vertexUploadBufferSize, size_t indexUploadBufferSize, const ImGui_ImplSlag_ViewportConfig& viewportConfig)
+{
+    //set backend data
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "imgui_impl_slag";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;
+    auto backendData = new ImGui_ImplSlag_Data();
+    io.BackendRendererUserData = backendData;
+
+    backendData->sampler = sampler;
+    backendData->platformData = platformData;
+    backendData->backBufferFormat = backBufferFormat;
+    //the default pipeline is needed for the first frame, the others a previous run used can be made while the rest of init runs
+    backendData->prewarmPipelines = IMGUI_IMPL_SLAG_PREWARM_PIPELINES & ~(1u<<ImGui_ImplSlag_Pipeline_Default);
+    if(backendData->prewarmPipelines)
+    {
+        backendData->pipelineThread = new std::thread(ImGui_Slag_PrewarmPipelinesJob,backendData);
+    }
+    ImGui_Slag_Pipeline(backendData,ImGui_ImplSlag_Pipeline_Default);
+    backendData->vertexUploadBufferSize = vertexUploadBufferSize;
+    backendData->indexUploadBufferSize = indexUploadBufferSize;
+    backendData->viewportConfig = viewportConfig;
+    backendData->parallelFor = IMGUI_IMPL_SLAG_PARALLEL_FOR;
+    backendData->parallelForUserData = IMGUI_IMPL_SLAG_PARALLEL_FOR_USER_DATA;
+    backendData->maxUploadJobs = IMGUI_IMPL_SLAG_MAX_UPLOAD_JOBS;
+    backendData->minUploadJobBytes = IMGUI_IMPL_SLAG_MIN_UPLOAD_JOB_BYTES;
+
+    //create dear imgui managed resources
+    bool asyncFontBuild = IMGUI_IMPL_SLAG_ASYNC_FONT_BUILD;
+    if(asyncFontBuild)
+    {
+        //frames are drawn with the default font from a small atlas of its own until the application's atlas is built on a worker thread and uploaded
+        backendData->pendingFontAtlas = io.Fonts;
+        backendData->pendingFontDefault = io.FontDefault;
+        backendData->fallbackFontAtlas = IM_NEW(ImFontAtlas)();
+        backendData->fallbackFontAtlas->AddFontDefault();
+        io.Fonts = backendData->fallbackFontAtlas;
+        io.FontDefault = nullptr;
+    }
+    int width, height;
+    bool singleChannel;
+    unsigned char* pixels = ImGui_Slag_BuildFontAtlas(backendData,io.Fonts,!asyncFontBuild,width,height,singleChannel);
+    backendData->fontsTexture = slag::Texture::newTexture(pixels,singleChannel ? slag::Pixels::R8_UNORM : slag::Pixels::R8G8B8A8_UNORM,width,height,1,slag::TextureUsageFlags::SAMPLED_IMAGE,slag::Texture::SHADER_RESOURCE);
+    //the gpu copy is all that's needed from here on
+    io.Fonts->ClearTexData();
+    ImGui_Slag_ReleaseFontCache(backendData);
+    if(asyncFontBuild)
+    {
+        //only started once the fallback atlas is built, so the two builds never run at the same time
+        backendData->fontBuildThread = new std::thread(ImGui_Slag_BuildFontAtlasJob,backendData);
+    }
+    else
+    {
+        ImGui_Slag_FontsReady(backendData,singleChannel);
+    }
+    backendData->textureDescriptorPool = slag::DescriptorPool::newDescriptorPool();
+    backendData->fontsTextureId = ImGui_ImplSlag_AddTexture(backendData->fontsTexture,sampler,singleChannel ? ImGui_ImplSlag_TextureChannels_Alpha : ImGui_ImplSlag_TextureChannels_RGBA);
+    io.Fonts->SetTexID(backendData->fontsTextureId);
+
+    auto viewportData = new ImGui_ImplSlag_ViewportData(mainSwapchain, true, vertexUploadBufferSize, indexUploadBufferSize);
+
+    auto mainViewport = ImGui::GetMainViewport();
+    mainViewport->RendererUserData = viewportData;
+
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    platformIo.Renderer_CreateWindow = ImGui_Slag_CreateWindow;
+    platformIo.Renderer_DestroyWindow = ImGui_Slag_DestroyWindow;
+    platformIo.Renderer_SetWindowSize = ImGui_Slag_SetWindowSize;
+    platformIo.Renderer_RenderWindow = ImGui_Slag_RenderWindow;
+    platformIo.Renderer_SwapBuffers = ImGui_Slag_SwapBuffers;
+
+    IMGUI_IMPL_SLAG_GET_NATIVE_WINDOW_HANDLE = extractNativeHandle;
+
+    return true;
+}
+
+void ImGui_ImplSlag_Shutdown()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto backend = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    for(int i=0; i<platformIo.Viewports.Size; i++)
+    {
+        auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(platformIo.Viewports[i]->RendererUserData);
+        if(viewportData)
+        {
+            ImGui_Slag_ClearWindowCaches(viewportData);
+        }
+    }
+    if(backend->fontBuildThread)
+    {
+        backend->fontBuildThread->join();
+        delete backend->fontBuildThread;
+    }
+    if(backend->fallbackFontAtlas)
+    {
+        //the application's atlas was never swapped in, give it back to imgui
+        io.Fonts = backend->pendingFontAtlas;
+        io.FontDefault = backend->pendingFontDefault;
+        IM_DELETE(backend->fallbackFontAtlas);
+    }
+    if(backend->pendingFontsTexture)
+    {
+        delete backend->pendingFontsTexture;
+    }
+    ImGui_Slag_ReleaseFontCache(backend);
+    if(backend->fontStagingBuffer)
+    {
+        delete backend->fontStagingBuffer;
+    }
+    //clean up IMGUI managed resources
+    for(auto& texture: backend->textures)
+    {
+        ImGui_Slag_ReleaseTextureEntry(backend,texture.second);
+    }
+    backend->textures.clear();
+    delete backend->fontsTexture;
+    if(backend->pipelineThread)
+    {
+        backend->pipelineThread->join();
+        delete backend->pipelineThread;
+    }
+    for(int i=0; i<ImGui_ImplSlag_Pipeline_COUNT; i++)
+    {
+        //prewarmed pipelines this run never got to use are still waiting to be taken
+        for(auto pipeline: {ImGui_Slag_PipelineSlot(backend,(ImGui_ImplSlag_Pipeline)i),backend->prewarmed[i]})
+        {
+            if(pipeline)
+            {
+                delete pipeline;
+            }
+        }
+    }
+    for(auto bundle: backend->bindlessBundles)
+    {
+        if(bundle)
+        {
+            delete bundle;
+        }
+    }
+    delete backend->textureDescriptorPool;
+    for(auto renderTarget: backend->renderTargets)
+    {
+        delete renderTarget;
+    }
+    if(backend->glyphUploadBuffer)
+    {
+        delete backend->glyphUploadBuffer;
+    }
+    for(auto lazyFont: IMGUI_IMPL_SLAG_LAZY_FONTS)
+    {
+        delete lazyFont;
+    }
+    IMGUI_IMPL_SLAG_LAZY_FONTS.clear();
+
+    delete backend;
+    io.BackendRendererUserData = nullptr;
+}
+
+//the ring buffer's current buffer and the ones it replaced that frames in flight still use
+uint64_t ImGui_Slag_RingBufferMemory(const ImGui_ImplSlag_RingBuffer& ringBuffer)
+{
+    uint64_t bytes = ringBuffer.buffer ? ringBuffer.capacity : 0;
+    for(auto& retired: ringBuffer.retiredBuffers)
+    {
+        bytes += retired.first->size();
+    }
+    return bytes;
+}
+void ImGui_Slag_CollectFrameStats(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_ViewportData* viewportData)
+{
+    rendererData->lastFrameSkippedCalls.scissors += viewportData->skippedCalls.scissors;
+    rendererData->lastFrameSkippedCalls.descriptorBundles += viewportData->skippedCalls.descriptorBundles;
+    rendererData->lastFrameSkippedCalls.vertexBuffers += viewportData->skippedCalls.vertexBuffers;
+    rendererData->lastFrameSkippedCalls.indexBuffers += viewportData->skippedCalls.indexBuffers;
+    viewportData->skippedCalls = ImGui_ImplSlag_SkippedCalls();
+
+    auto& stats = rendererData->lastFrameStats;
+    stats.drawCalls += viewportData->frameStats.drawCalls;
+    stats.indices += viewportData->frameStats.indices;
+    stats.vertexBytesUploaded += viewportData->frameStats.vertexBytesUploaded;
+    stats.indexBytesUploaded += viewportData->frameStats.indexBytesUploaded;
+    stats.bufferAllocations += viewportData->frameStats.bufferAllocations;
+    stats.descriptorBinds += viewportData->frameStats.descriptorBinds;
+    stats.scissorChanges += viewportData->frameStats.scissorChanges;
+    stats.callbacks += viewportData->frameStats.callbacks;
+    stats.viewportsRendered += viewportData->frameStats.viewportsRendered;
+    viewportData->frameStats = ImGui_ImplSlag_FrameStats();
+
+    stats.gpuMemoryBytes += ImGui_Slag_RingBufferMemory(viewportData->vertexBuffer);
+    stats.gpuMemoryBytes += ImGui_Slag_RingBufferMemory(viewportData->indexBuffer);
+    stats.gpuMemoryBytes += ImGui_Slag_RingBufferMemory(viewportData->indirectBuffer);
+    if(viewportData->residentVertices)
+    {
+        stats.gpuMemoryBytes += viewportData->residentVertices->buffer->size() + viewportData->residentIndices->buffer->size();
+    }
+    //window cache textures have the back buffer's format, assumed to be 4 bytes a pixel
+    for(auto& cache: viewportData->windowCaches)
+    {
+        if(cache.second->texture)
+        {
+            stats.gpuMemoryBytes += (uint64_t)cache.second->texture->width()*cache.second->texture->height()*4;
+        }
+    }
+}
+//starts timing a scope on the gpu, false if profiling is off or this frame has no queries left. The scope ends with ImGui_Slag_EndTimestamp(query)
+bool ImGui_Slag_BeginTimestamp(ImGui_ImplSlag_Data* rendererData, slag::CommandBuffer* commandBuffer, ImGuiID viewportId, ImGuiID windowId, uint32_t& query)
+{
+    if(!rendererData->timestampsActive)
+    {
+        return false;
+    }
+    uint32_t used = rendererData->timestampQueriesUsed.fetch_add(2,std::memory_order_relaxed);
+    if(used+2 > rendererData->timestampQueriesPerFrame)
+    {
+        return false;
+    }
+    query = rendererData->timestampRange*rendererData->timestampQueriesPerFrame+used;
+    auto& scope = rendererData->timestampScopes[query/2];
+    scope.viewportId = viewportId;
+    scope.windowId = windowId;
+    rendererData->writeTimestamp(commandBuffer,query,rendererData->timestampUserData);
+    return true;
+}
+void ImGui_Slag_EndTimestamp(ImGui_ImplSlag_Data* rendererData, slag::CommandBuffer* commandBuffer, uint32_t query)
+{
+    rendererData->writeTimestamp(commandBuffer,query+1,rendererData->timestampUserData);
+}
+//reads back every range of queries the gpu has finished with, and picks the range the new frame writes into
+void ImGui_Slag_ResolveTimestamps(ImGui_ImplSlag_Data* rendererData)
+{
+    if(rendererData->writeTimestamp == nullptr)
+    {
+        return;
+    }
+    const int rangeCount = IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1;
+    if(rendererData->timestampsActive)
+    {
+        rendererData->pendingTimestampQueries[rendererData->timestampRange] = std::min(rendererData->timestampQueriesUsed.load(std::memory_order_relaxed),rendererData->timestampQueriesPerFrame);
+    }
+    //oldest first, so the newest finished frame is what's left in gpuTimings
+    for(int i=1; i<=rangeCount; i++)
+    {
+        int range = (rendererData->timestampRange+i)%rangeCount;
+        uint32_t queryCount = rendererData->pendingTimestampQueries[range];
+        uint32_t firstQuery = range*rendererData->timestampQueriesPerFrame;
+        if(queryCount == 0 || !rendererData->readTimestamps(firstQuery,queryCount,rendererData->timestampTicks.data(),rendererData->timestampUserData))
+        {
+            continue;
+        }
+        rendererData->pendingTimestampQueries[range] = 0;
+        rendererData->gpuTimings.resize(0);
+        for(uint32_t query=0; query+1<queryCount; query+=2)
+        {
+            const auto& scope = rendererData->timestampScopes[(firstQuery+query)/2];
+            uint64_t begin = rendererData->timestampTicks[query];
+            uint64_t end = rendererData->timestampTicks[query+1];
+            float milliseconds = end > begin ? (float)((end-begin)*rendererData->nanosecondsPerTick/1000000.0) : 0.0f;
+            //a viewport drawn more than once in a frame adds up
+            ImGui_ImplSlag_GpuTiming* timing = nullptr;
+            for(auto& existing: rendererData->gpuTimings)
+            {
+                if(existing.viewportId == scope.viewportId && existing.windowId == scope.windowId)
+                {
+                    timing = &existing;
+                    break;
+                }
+            }
+            if(timing == nullptr)
+            {
+                rendererData->gpuTimings.push_back(scope);
+                timing = &rendererData->gpuTimings.back();
+                timing->milliseconds = 0.0f;
+            }
+            timing->milliseconds += milliseconds;
+        }
+    }
+    rendererData->timestampRange = (rendererData->timestampRange+1)%rangeCount;
+    rendererData->timestampsActive = rendererData->pendingTimestampQueries[rendererData->timestampRange] == 0;
+    rendererData->timestampQueriesUsed.store(0,std::memory_order_relaxed);
+}
+void ImGui_ImplSlag_NewFrame(slag::DescriptorPool* framePool)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_NewFrame");
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    rendererData->descriptorPool = framePool;
+    rendererData->lastFrameSkippedCalls = ImGui_ImplSlag_SkippedCalls();
+    rendererData->lastFrameStats = ImGui_ImplSlag_FrameStats();
+    ImGui_Slag_ResolveTimestamps(rendererData);
+    //the application's font atlas was uploaded last frame, swap it in before imgui starts using fonts
+    if(rendererData->pendingFontsTexture)
+    {
+        ImGui_ImplSlag_RemoveTexture(rendererData->fontsTextureId,true);
+        rendererData->fontsTexture = rendererData->pendingFontsTexture;
+        rendererData->pendingFontsTexture = nullptr;
+        rendererData->fontsTextureId = ImGui_ImplSlag_AddTexture(rendererData->fontsTexture,rendererData->sampler,rendererData->pendingFontsSingleChannel ? ImGui_ImplSlag_TextureChannels_Alpha : ImGui_ImplSlag_TextureChannels_RGBA);
+        io.Fonts = rendererData->pendingFontAtlas;
+        io.FontDefault = rendererData->pendingFontDefault;
+        io.Fonts->SetTexID(rendererData->fontsTextureId);
+        //unused bindless slots still hold the fallback font, which is deleted once it retires
+        rendererData->bindlessFillVersion = ++rendererData->bindlessVersion;
+        IM_DELETE(rendererData->fallbackFontAtlas);
+        rendererData->fallbackFontAtlas = nullptr;
+        rendererData->pendingFontAtlas = nullptr;
+        ImGui_Slag_FontsReady(rendererData,rendererData->pendingFontsSingleChannel);
+        //anything drawn with the fallback font is out of date
+        ImGui_ImplSlag_InvalidateViewports();
+    }
+    assert(rendererData->openLazyTextRanges.empty() && "ImGui_ImplSlag_PushLazyFont without a matching ImGui_ImplSlag_PopLazyFont");
+    rendererData->lazyTextRanges.clear();
+    //the atlas stays built with its pixels only on the gpu. GetTexDataAsAlpha8/RGBA32 since then has rasterized it again, which never reaches the gpu and, for an atlas mapped from the cache, no longer matches the glyphs it was packed with
+    assert(io.Fonts->TexPixelsAlpha8 == nullptr && io.Fonts->TexPixelsRGBA32 == nullptr && "The font atlas was built again after ImGui_ImplSlag_Init, its pixels are only on the gpu");
+    if(rendererData->fontStagingBuffer && ImGui::GetFrameCount() >= rendererData->fontStagingRetireFrame)
+    {
+        delete rendererData->fontStagingBuffer;
+        rendererData->fontStagingBuffer = nullptr;
+    }
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    for(int i=0; i<platformIo.Viewports.Size; i++)
+    {
+        auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(platformIo.Viewports[i]->RendererUserData);
+        if(viewportData)
+        {
+            ImGui_Slag_CollectFrameStats(rendererData,viewportData);
+        }
+    }
+    for(auto renderTarget: rendererData->renderTargets)
+    {
+        ImGui_Slag_CollectFrameStats(rendererData,renderTarget);
+    }
+    //memory that isn't any one viewport's
+    auto& stats = rendererData->lastFrameStats;
+    //the fallback atlas of an async font build can be single channel while the application's isn't
+    auto fontsEntry = rendererData->textureIds.find(rendererData->fontsTextureId);
+    bool fontsSingleChannel = fontsEntry != rendererData->textureIds.end() && fontsEntry->second->channels != ImGui_ImplSlag_TextureChannels_RGBA;
+    stats.gpuMemoryBytes += (uint64_t)rendererData->fontsTexture->width()*rendererData->fontsTexture->height()*(fontsSingleChannel ? 1 : 4);
+    if(rendererData->pendingFontsTexture)
+    {
+        stats.gpuMemoryBytes += (uint64_t)rendererData->pendingFontsTexture->width()*rendererData->pendingFontsTexture->height()*(rendererData->pendingFontsSingleChannel ? 1 : 4);
+    }
+    if(rendererData->fontStagingBuffer)
+    {
+        stats.gpuMemoryBytes += rendererData->fontStagingBuffer->size();
+    }
+    if(rendererData->glyphUploadBuffer)
+    {
+        stats.gpuMemoryBytes += ImGui_Slag_RingBufferMemory(*rendererData->glyphUploadBuffer);
+    }
+    rendererData->frameStatsHistory[rendererData->frameStatsHistoryOffset] = stats;
+    rendererData->frameStatsHistoryOffset = (rendererData->frameStatsHistoryOffset+1)%IMGUI_IMPL_SLAG_FRAME_STATS_HISTORY;
+    //free textures whose last frames have finished
+    for(size_t i=0; i<rendererData->retiringTextures.size();)
+    {
+        auto entry = rendererData->retiringTextures[i];
+        if(entry->retireFrame <= ImGui::GetFrameCount())
+        {
+            rendererData->textures.erase({entry->texture,entry->sampler});
+            ImGui_Slag_ReleaseTextureEntry(rendererData,entry);
+            rendererData->retiringTextures.erase(rendererData->retiringTextures.begin()+i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+    if(rendererData->bindless)
+    {
+        //this copy of the array was last used MAX_FRAMES_IN_FLIGHT+1 frames ago, so it's safe to rewrite if textures have changed since
+        auto index = ImGui::GetFrameCount() % rendererData->bindlessBundles.size();
+        if(rendererData->bindlessBundles[index] == nullptr)
+        {
+            rendererData->bindlessBundles[index] = new slag::DescriptorBundle(rendererData->textureDescriptorPool->makeBundle(rendererData->bindlessShaderPipeline->descriptorGroup(0)));
+        }
+        uint64_t& written = rendererData->bindlessBundleVersions[index];
+        if(written != rendererData->bindlessVersion)
+        {
+            //the shaders declare all IMGUI_IMPL_SLAG_BINDLESS_TEXTURE_COUNT slots, so a new copy, or one written before the font changed, gets every slot with the font in the unused ones. After that only slots that changed since are written
+            bool whole = written == 0 || written < rendererData->bindlessFillVersion;
+            uint32_t slotCount = whole ? IMGUI_IMPL_SLAG_BINDLESS_TEXTURE_COUNT : rendererData->bindlessTextures.size();
+            for(uint32_t i=0; i<slotCount; i++)
+            {
+                if(!whole && rendererData->bindlessSlotVersions[i] <= written)
+                {
+                    continue;
+                }
+                if(i < rendererData->bindlessTextures.size() && rendererData->bindlessTextures[i].first)
+                {
+                    auto& slot = rendererData->bindlessTextures[i];
+                    rendererData->bindlessBundles[index]->setSamplerAndTexture(0,i,slot.first, slag::Texture::SHADER_RESOURCE,slot.second);
+                }
+                else
+                {
+                    rendererData->bindlessBundles[index]->setSamplerAndTexture(0,i,rendererData->fontsTexture, slag::Texture::SHADER_RESOURCE,rendererData->sampler);
+                }
+            }
+            written = rendererData->bindlessVersion;
+        }
+        rendererData->bindlessBundle = rendererData->bindlessBundles[index];
+        rendererData->bindlessBundleBound = false;
+    }
+}
+//updates boundState after one of the backend's own callbacks switched pipelines, false for user callbacks
+bool ImGui_Slag_ApplyInternalCallback(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_BoundState& boundState, ImDrawCallback callback)
+{
+    slag::ShaderPipeline* pipeline = ImGui_Slag_InternalCallbackPipeline(rendererData,callback);
+    if(pipeline == nullptr)
+    {
+        return false;
+    }
+    boundState.pipeline = pipeline;
+    boundState.arrayPipeline = pipeline;
+    //cached windows are rgba, sdf text is drawn from the font atlas whose distances the sdf pipelines read from whichever channel it has
+    boundState.channels = ImGui_ImplSlag_TextureChannels_RGBA;
+    if(callback == ImGui_Slag_UseSdfPipeline)
+    {
+        auto fonts = rendererData->textureIds.find(rendererData->fontsTextureId);
+        if(fonts != rendererData->textureIds.end())
+        {
+            boundState.channels = fonts->second->channels;
+        }
+    }
+    //the next draw binds its bundle again, so it's checked against the new channels
+    boundState.descriptorBundle = nullptr;
+    return true;
+}
+//updates boundState after a callback other than ImDrawCallback_ResetRenderState has run, drawn with the draw data's shader
+void ImGui_Slag_ApplyUserCallback(ImGui_ImplSlag_Data* rendererData, slag::ShaderPipeline* shader, ImGui_ImplSlag_BoundState& boundState, ImDrawCallback callback)
+{
+    if(ImGui_Slag_ApplyInternalCallback(rendererData,boundState,callback))
+    {
+        return;
+    }
+    //descriptors are still bound against the draw data's pipeline, whatever the callback bound is kept until the render state is reset
+    boundState.invalidate();
+    boundState.pipeline = shader;
+    boundState.arrayPipeline = shader;
+    boundState.pipelinePinned = true;
+}
+//updates boundState for a draw of textureId, false if its bundle is already bound. switchTo is set when the texture's channels need another pipeline bound first, and bindPool when its bundle comes from another pool
+bool ImGui_Slag_PrepareDraw(ImGui_ImplSlag_Data* rendererData, slag::ShaderPipeline* shader, ImGui_ImplSlag_BoundState& boundState, ImTextureID textureId, slag::ShaderPipeline*& switchTo, slag::DescriptorPool*& bindPool)
+{
+    switchTo = nullptr;
+    bindPool = nullptr;
+    auto descriptorBundle = (slag::DescriptorBundle*)textureId;
+    if(descriptorBundle == boundState.descriptorBundle)
+    {
+        return false;
+    }
+    //registered textures are in the backend's pool, raw bundles are the application's, from the frame pool
+    auto entry = rendererData->textureIds.find(textureId);
+    auto pool = entry != rendererData->textureIds.end() ? rendererData->textureDescriptorPool : rendererData->descriptorPool;
+    //without a frame pool there's nothing to go back to once the backend's own pool was bound
+    assert((pool != nullptr || boundState.descriptorPool == nullptr) && "Raw descriptor bundles need the frame pool given to ImGui_ImplSlag_NewFrame");
+    if(pool != nullptr && pool != boundState.descriptorPool)
+    {
+        bindPool = pool;
+        boundState.descriptorPool = pool;
+    }
+    //single channel textures need their own pipeline
+    auto channels = entry != rendererData->textureIds.end() ? entry->second->channels : ImGui_ImplSlag_TextureChannels_RGBA;
+    if(channels != boundState.channels && !boundState.pipelinePinned)
+    {
+        switchTo = ImGui_Slag_ChannelsShaderPipeline(rendererData,shader,channels);
+        boundState.pipeline = switchTo;
+        boundState.channels = channels;
+    }
+    boundState.descriptorBundle = descriptorBundle;
+    return true;
+}
+//binds the frame pool given to ImGui_ImplSlag_NewFrame again if the backend's own pool replaced it, so the application finds its pool where it left it
+void ImGui_Slag_RestoreFramePool(ImGui_ImplSlag_Data* rendererData, slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_BoundState& boundState)
+{
+    if(boundState.descriptorPool != nullptr && rendererData->descriptorPool != nullptr && boundState.descriptorPool != rendererData->descriptorPool)
+    {
+        commandBuffer->bindDescriptorPool(rendererData->descriptorPool);
+        boundState.descriptorPool = rendererData->descriptorPool;
+    }
+}
+
+void ImGui_ImplSlag_PushTransform(ImDrawData* draw_data, slag::ShaderPipeline* pipeline, slag::CommandBuffer* commandBuffer);
+//binds the bindless array again before it's multi drawn from if raw bundles or a callback replaced it
+void ImGui_Slag_BindBindlessArray(ImGui_ImplSlag_Data* rendererData, ImDrawData* draw_data, slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_BoundState& boundState, ImGui_ImplSlag_ViewportData* viewportData)
+{
+    if(boundState.descriptorBundle == rendererData->bindlessBundle)
+    {
+        return;
+    }
+    if(boundState.pipeline != boundState.arrayPipeline)
+    {
+        ImGui_Slag_BindPipeline(rendererData,commandBuffer,boundState.arrayPipeline);
+        ImGui_ImplSlag_PushTransform(draw_data,boundState.arrayPipeline,commandBuffer);
+        boundState.pipeline = boundState.arrayPipeline;
+    }
+    if(boundState.descriptorPool != rendererData->textureDescriptorPool)
+    {
+        commandBuffer->bindDescriptorPool(rendererData->textureDescriptorPool);
+        boundState.descriptorPool = rendererData->textureDescriptorPool;
+    }
+    commandBuffer->bindGraphicsDescriptorBundle(boundState.pipeline,0,*rendererData->bindlessBundle);
+    rendererData->bindlessBundleBound = true;
+    viewportData->frameStats.descriptorBinds++;
+    boundState.descriptorBundle = rendererData->bindlessBundle;
+}
+
+void ImGui_ImplSlag_SetScissor(slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_BoundState& boundState, ImGui_ImplSlag_ViewportData* viewportData, const slag::Rectangle& scissor)
+{
+    if(boundState.hasScissor &&
+       boundState.scissor.offset.x == scissor.offset.x && boundState.scissor.offset.y == scissor.offset.y &&
+       boundState.scissor.extent.width == scissor.extent.width && boundState.scissor.extent.height == scissor.extent.height)
+    {
+        viewportData->skippedCalls.scissors++;
+        return;
+    }
+    commandBuffer->setScissors(scissor);
+    viewportData->frameStats.scissorChanges++;
+    boundState.hasScissor = true;
+    boundState.scissor = scissor;
+}
+
+//a run of indirect draws that share a scissor, recorded as a single multi draw
+struct ImGui_ImplSlag_IndirectBatch
+{
+    uint32_t firstCommand = 0;
+    uint32_t commandCount = 0;
+    slag::Rectangle scissor{};
+};
+
+void ImGui_ImplSlag_FlushIndirectBatch(slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_BoundState& boundState, ImGui_ImplSlag_ViewportData* viewportData, ImGui_ImplSlag_IndirectBatch& batch, slag::Buffer* indirectBuffer, size_t indirectBufferOffset)
+{
+    if(batch.commandCount == 0)
+    {
+        return;
+    }
+    ImGui_ImplSlag_SetScissor(commandBuffer,boundState,viewportData,batch.scissor);
+    commandBuffer->drawIndexedIndirect(indirectBuffer,indirectBufferOffset+batch.firstCommand*sizeof(ImGui_ImplSlag_IndirectDrawCommand),batch.commandCount,sizeof(ImGui_ImplSlag_IndirectDrawCommand));
+    viewportData->frameStats.drawCalls++;
+    batch.firstCommand += batch.commandCount;
+    batch.commandCount = 0;
+}
+
+void ImGui_ImplSlag_BindBuffers(slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_BoundState& boundState, ImGui_ImplSlag_ViewportData* viewportData, slag::Buffer* vertexBuffer, size_t vertexBufferOffset, size_t vertexBufferSize, slag::Buffer* indexBuffer, size_t indexBufferOffset)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto slagData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(boundState.vertexBuffer == vertexBuffer && boundState.vertexBufferOffset == vertexBufferOffset)
+    {
+        viewportData->skippedCalls.vertexBuffers++;
+    }
+    else
+    {
+        size_t stride = slagData->compactVertices ? sizeof(ImGui_ImplSlag_CompactVert) : sizeof(ImDrawVert);
+        commandBuffer->bindVertexBuffers(0,&vertexBuffer,&vertexBufferOffset,&vertexBufferSize,&stride,1);
+        boundState.vertexBuffer = vertexBuffer;
+        boundState.vertexBufferOffset = vertexBufferOffset;
+    }
+    if(boundState.indexBuffer == indexBuffer && boundState.indexBufferOffset == indexBufferOffset)
+    {
+        viewportData->skippedCalls.indexBuffers++;
+    }
+    else
+    {
+        commandBuffer->bindIndexBuffer(indexBuffer,sizeof(ImDrawIdx) == 2 ? slag::Buffer::UINT16: slag::Buffer::UINT32,indexBufferOffset);
+        boundState.indexBuffer = indexBuffer;
+        boundState.indexBufferOffset = indexBufferOffset;
+    }
+}
+void ImGui_ImplSlag_SetupRenderState(ImDrawData* draw_data, slag::ShaderPipeline* pipeline, slag::CommandBuffer* commandBuffer, slag::Buffer* vertexBuffer, size_t vertexBufferOffset, size_t vertexBufferSize, slag::Buffer* indexBuffer, size_t indexBufferOffset, uint32_t frameBufferWidth, uint32_t frameBufferHeight, ImGui_ImplSlag_BoundState& boundState, ImGui_ImplSlag_ViewportData* viewportData)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto slagData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+
+    //everything is bound again from scratch, so the pipeline, its channels and the bundle can't disagree. The frame pool goes back first so forgetting the bound pool doesn't leave the backend's in place
+    ImGui_Slag_RestoreFramePool(slagData,commandBuffer,boundState);
+    boundState.reset(pipeline);
+    ImGui_Slag_BindPipeline(slagData,commandBuffer,pipeline);
+    if(slagData->bindless)
+    {
+        //the array lives in the backend's own pool
+        commandBuffer->bindDescriptorPool(slagData->textureDescriptorPool);
+        boundState.descriptorPool = slagData->textureDescriptorPool;
+        commandBuffer->bindGraphicsDescriptorBundle(pipeline,0,*slagData->bindlessBundle);
+        slagData->bindlessBundleBound = true;
+        viewportData->frameStats.descriptorBinds++;
+        boundState.descriptorBundle = slagData->bindlessBundle;
+    }
+
+
+    // Bind Vertex And Index Buffer:
+    if (draw_data->TotalVtxCount > 0)
+    {
+        ImGui_ImplSlag_BindBuffers(commandBuffer,boundState,viewportData,vertexBuffer,vertexBufferOffset,vertexBufferSize,indexBuffer,indexBufferOffset);
+    }
+
+    commandBuffer->setViewPort(0,0,frameBufferWidth,frameBufferHeight,1,0);
+    ImGui_ImplSlag_PushTransform(draw_data,pipeline,commandBuffer);
+}
+void ImGui_ImplSlag_PushTransform(ImDrawData* draw_data, slag::ShaderPipeline* pipeline, slag::CommandBuffer* commandBuffer)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto slagData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    {
+        float scale[2];
+        scale[0] = 2.0f / draw_data->DisplaySize.x;
+        scale[1] = 2.0f / draw_data->DisplaySize.y;
+        float translate[2];
+        translate[0] =  -1.0f - draw_data->DisplayPos.x * scale[0];
+        translate[1] = -1.0f - draw_data->DisplayPos.y * scale[1];
+        if(slagData->compactVertices)
+        {
+            //positions arrive as snorm relative to DisplayPos, undo the snorm and fixed point scaling and drop the display offset
+            scale[0] *= 32767.0f / IMGUI_IMPL_SLAG_COMPACT_POSITION_SCALE;
+            scale[1] *= 32767.0f / IMGUI_IMPL_SLAG_COMPACT_POSITION_SCALE;
+            translate[0] = -1.0f;
+            translate[1] = -1.0f;
+        }
+        commandBuffer->pushConstants(pipeline,slag::ShaderStageFlags::VERTEX,0,sizeof(float)*2,scale);
+        commandBuffer->pushConstants(pipeline,slag::ShaderStageFlags::VERTEX,sizeof(float)*2,sizeof(float)*2,translate);
+    }
+}
+//already scaled value to a 16 bit snorm's bit pattern, -32768 is avoided since it decodes the same as -32767
+inline uint32_t ImGui_Slag_PackSnorm(float value)
+{
+    int32_t quantized = (int32_t)std::clamp(value + (value < 0.0f ? -0.5f : 0.5f), -32767.0f, 32767.0f);
+    return (uint32_t)(uint16_t)(int16_t)quantized;
+}
+inline uint32_t ImGui_Slag_PackUnorm(float value)
+{
+    return (uint32_t)(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+}
+void ImGui_Slag_UploadJob(uint32_t jobIndex, void* jobData)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("upload job");
+    auto jobs = static_cast<ImGui_ImplSlag_UploadJobs*>(jobData);
+    //every list's destination was decided up front, so jobs never touch the same bytes and the layout doesn't depend on which finishes first
+    for(int i=jobs->jobFirstList[jobIndex]; i<jobs->jobFirstList[jobIndex+1]; i++)
+    {
+        const ImDrawList* draw_list = jobs->drawData->CmdLists[i];
+        if(jobs->vertexBuffers[i] == nullptr)
+        {
+            continue;
+        }
+        if(jobs->compactVertices)
+        {
+            auto& packed = jobs->packedVertices[jobIndex];
+            packed.resize(draw_list->VtxBuffer.Size);
+            ImVec2 displayPos = jobs->drawData->DisplayPos;
+            for(int v=0; v<draw_list->VtxBuffer.Size; v++)
+            {
+                const ImDrawVert& vertex = draw_list->VtxBuffer.Data[v];
+                packed[v].pos = ImGui_Slag_PackSnorm((vertex.pos.x - displayPos.x) * IMGUI_IMPL_SLAG_COMPACT_POSITION_SCALE) | (ImGui_Slag_PackSnorm((vertex.pos.y - displayPos.y) * IMGUI_IMPL_SLAG_COMPACT_POSITION_SCALE) << 16);
+                packed[v].uv = ImGui_Slag_PackUnorm(vertex.uv.x) | (ImGui_Slag_PackUnorm(vertex.uv.y) << 16);
+                packed[v].col = vertex.col;
+            }
+            jobs->vertexBuffers[i]->update(jobs->vertexOffsets[i],packed.data(),packed.size()*sizeof(ImGui_ImplSlag_CompactVert));
+        }
+        else
+        {
+            jobs->vertexBuffers[i]->update(jobs->vertexOffsets[i],draw_list->VtxBuffer.Data,draw_list->VtxBuffer.size_in_bytes());
+        }
+        jobs->indexBuffers[i]->update(jobs->indexOffsets[i],draw_list->IdxBuffer.Data,draw_list->IdxBuffer.size_in_bytes());
+    }
+}
+//decides which draw lists are drawn from the viewport's resident buffers this frame, lists have to hash the same two frames in a row to become resident
+void ImGui_Slag_UpdateResidentLists(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_ViewportData* rendererViewportData, ImDrawData* draw_data)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("update resident lists");
+    auto& residentLists = rendererViewportData->residentLists;
+    int frame = ImGui::GetFrameCount();
+    int retireFrame = frame + IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT + 1;
+    bool enabled = rendererData->cacheDrawLists && rendererViewportData->swapchain != nullptr;
+    if(!enabled || rendererViewportData->residentCompact != rendererData->compactVertices)
+    {
+        //the stored lists are in the wrong format or not wanted anymore
+        for(auto& list: residentLists)
+        {
+            if(list.second.resident)
+            {
+                rendererViewportData->residentVertices->free(list.second.firstVertex,list.second.vertexCount,retireFrame);
+                rendererViewportData->residentIndices->free(list.second.firstIndex,list.second.indexCount,retireFrame);
+            }
+        }
+        residentLists.clear();
+        rendererViewportData->residentCompact = rendererData->compactVertices;
+    }
+    if(!enabled)
+    {
+        return;
+    }
+    if(rendererViewportData->residentVertices == nullptr)
+    {
+        rendererViewportData->residentVertices = new ImGui_ImplSlag_ResidentBuffer(rendererData->residentVertexCapacity,sizeof(ImDrawVert),slag::Buffer::VERTEX_BUFFER);
+        rendererViewportData->residentIndices = new ImGui_ImplSlag_ResidentBuffer(rendererData->residentIndexCapacity,sizeof(ImDrawIdx),slag::Buffer::INDEX_BUFFER);
+        rendererViewportData->frameStats.bufferAllocations += 2;
+    }
+    auto residentVertices = rendererViewportData->residentVertices;
+    auto residentIndices = rendererViewportData->residentIndices;
+    residentVertices->collect(frame);
+    residentIndices->collect(frame);
+
+    //compact positions are relative to the display, so they're only the same if it hasn't moved
+    uint64_t seed = 0xcbf29ce484222325ull;
+    if(rendererData->compactVertices)
+    {
+        seed = ImGui_Slag_HashBytes(&draw_data->DisplayPos,sizeof(ImVec2),seed);
+    }
+    for(int i=0; i<draw_data->CmdListsCount; i++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[i];
+        if(draw_list->VtxBuffer.Size == 0)
+        {
+            continue;
+        }
+        uint64_t hash = ImGui_Slag_HashBytes(draw_list->VtxBuffer.Data,draw_list->VtxBuffer.size_in_bytes(),seed);
+        hash = ImGui_Slag_HashBytes(draw_list->IdxBuffer.Data,draw_list->IdxBuffer.size_in_bytes(),hash);
+        auto& list = residentLists[draw_list];
+        list.lastSeenFrame = frame;
+        list.needsUpload = false;
+        if(list.hash != hash)
+        {
+            if(list.resident)
+            {
+                residentVertices->free(list.firstVertex,list.vertexCount,retireFrame);
+                residentIndices->free(list.firstIndex,list.indexCount,retireFrame);
+                list.resident = false;
+            }
+            list.hash = hash;
+            list.unchangedFrames = 0;
+            continue;
+        }
+        list.unchangedFrames++;
+        if(!list.resident)
+        {
+            uint32_t firstVertex = 0;
+            uint32_t firstIndex = 0;
+            if(!residentVertices->allocate(draw_list->VtxBuffer.Size,firstVertex))
+            {
+                continue;
+            }
+            if(!residentIndices->allocate(draw_list->IdxBuffer.Size,firstIndex))
+            {
+                //nothing was written to it, it can be reused right away
+                residentVertices->free(firstVertex,draw_list->VtxBuffer.Size,frame);
+                residentVertices->collect(frame);
+                continue;
+            }
+            list.resident = true;
+            list.needsUpload = true;
+            list.firstVertex = firstVertex;
+            list.vertexCount = draw_list->VtxBuffer.Size;
+            list.firstIndex = firstIndex;
+            list.indexCount = draw_list->IdxBuffer.Size;
+        }
+    }
+
+    //lists that weren't drawn this time, their windows are hidden or gone
+    for(auto it = residentLists.begin(); it != residentLists.end();)
+    {
+        if(it->second.lastSeenFrame != frame)
+        {
+            if(it->second.resident)
+            {
+                residentVertices->free(it->second.firstVertex,it->second.vertexCount,retireFrame);
+                residentIndices->free(it->second.firstIndex,it->second.indexCount,retireFrame);
+            }
+            it = residentLists.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+//works out where every draw list is read from this frame and copies the ones that need it, returns the bytes needed in the upload buffers
+void ImGui_Slag_PlanListSources(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_ViewportData* rendererViewportData, ImDrawData* draw_data, size_t& vertexBytes, size_t& indexBytes)
+{
+    auto& sources = rendererViewportData->listSources;
+    sources.resize(draw_data->CmdListsCount);
+    uint32_t uploadedVertices = 0;
+    uint32_t uploadedIndices = 0;
+    for(int i=0; i<draw_data->CmdListsCount; i++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[i];
+        auto& source = sources[i];
+        source = ImGui_ImplSlag_ListSource();
+        auto found = rendererViewportData->residentLists.find(draw_list);
+        if(found != rendererViewportData->residentLists.end() && found->second.resident)
+        {
+            source.vertexBuffer = rendererViewportData->residentVertices->buffer;
+            source.vertexBufferSize = rendererViewportData->residentVertices->buffer->size();
+            source.indexBuffer = rendererViewportData->residentIndices->buffer;
+            source.firstVertex = found->second.firstVertex;
+            source.firstIndex = found->second.firstIndex;
+            continue;
+        }
+        source.firstVertex = uploadedVertices;
+        source.firstIndex = uploadedIndices;
+        uploadedVertices += draw_list->VtxBuffer.Size;
+        uploadedIndices += draw_list->IdxBuffer.Size;
+    }
+    vertexBytes = uploadedVertices*(rendererData->compactVertices ? sizeof(ImGui_ImplSlag_CompactVert) : sizeof(ImDrawVert));
+    indexBytes = uploadedIndices*sizeof(ImDrawIdx);
+}
+void ImGui_Slag_UploadDrawLists(ImGui_ImplSlag_Data* rendererData, ImGui_ImplSlag_ViewportData* rendererViewportData, ImDrawData* draw_data, slag::Buffer* vertexBuffer, size_t vertexBufferOffset, size_t vertexBufferSize, slag::Buffer* indexBuffer, size_t indexBufferOffset)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("upload draw lists");
+    auto& jobs = rendererViewportData->uploadJobs;
+    auto& sources = rendererViewportData->listSources;
+    jobs.drawData = draw_data;
+    jobs.compactVertices = rendererData->compactVertices;
+    size_t vertexSize = jobs.compactVertices ? sizeof(ImGui_ImplSlag_CompactVert) : sizeof(ImDrawVert);
+    jobs.vertexBuffers.resize(draw_data->CmdListsCount);
+    jobs.indexBuffers.resize(draw_data->CmdListsCount);
+    jobs.vertexOffsets.resize(draw_data->CmdListsCount);
+    jobs.indexOffsets.resize(draw_data->CmdListsCount);
+    jobs.uploadedBytes.resize(draw_data->CmdListsCount+1);
+    jobs.uploadedBytes[0] = 0;
+    for(int i=0; i<draw_data->CmdListsCount; i++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[i];
+        auto& source = sources[i];
+        jobs.vertexBuffers[i] = nullptr;
+        jobs.indexBuffers[i] = nullptr;
+        if(source.vertexBuffer == nullptr)
+        {
+            //uploaded every frame
+            source.vertexBuffer = vertexBuffer;
+            source.vertexBufferOffset = vertexBufferOffset;
+            source.vertexBufferSize = vertexBufferSize;
+            source.indexBuffer = indexBuffer;
+            source.indexBufferOffset = indexBufferOffset;
+            jobs.vertexBuffers[i] = vertexBuffer;
+            jobs.indexBuffers[i] = indexBuffer;
+        }
+        else if(rendererViewportData->residentLists[draw_list].needsUpload)
+        {
+            //just became resident, copied once
+            jobs.vertexBuffers[i] = source.vertexBuffer;
+            jobs.indexBuffers[i] = source.indexBuffer;
+        }
+        jobs.vertexOffsets[i] = source.vertexBufferOffset + source.firstVertex*vertexSize;
+        jobs.indexOffsets[i] = source.indexBufferOffset + source.firstIndex*sizeof(ImDrawIdx);
+        size_t listVertexBytes = jobs.vertexBuffers[i] ? draw_list->VtxBuffer.Size*vertexSize : 0;
+        size_t listIndexBytes = jobs.vertexBuffers[i] ? draw_list->IdxBuffer.size_in_bytes() : 0;
+        rendererViewportData->frameStats.vertexBytesUploaded += listVertexBytes;
+        rendererViewportData->frameStats.indexBytesUploaded += listIndexBytes;
+        jobs.uploadedBytes[i+1] = jobs.uploadedBytes[i] + listVertexBytes + listIndexBytes;
+    }
+
+    size_t totalBytes = jobs.uploadedBytes[draw_data->CmdListsCount];
+    uint32_t jobCount = 1;
+    //viewports already being recorded in parallel don't split their uploads any further
+    if(rendererData->parallelFor && rendererData->minUploadJobBytes > 0 && !IMGUI_IMPL_SLAG_RECORDING_IN_PARALLEL)
+    {
+        jobCount = std::clamp((uint32_t)(totalBytes / rendererData->minUploadJobBytes), 1u, rendererData->maxUploadJobs);
+    }
+    if(jobCount > (uint32_t)draw_data->CmdListsCount)
+    {
+        jobCount = draw_data->CmdListsCount;
+    }
+
+    //split the lists so each job copies about the same number of bytes
+    jobs.jobFirstList.resize(jobCount+1);
+    jobs.jobFirstList[0] = 0;
+    int list = 0;
+    for(uint32_t job=1; job<jobCount; job++)
+    {
+        size_t target = totalBytes * job / jobCount;
+        while(list < draw_data->CmdListsCount && jobs.uploadedBytes[list] < target)
+        {
+            list++;
+        }
+        jobs.jobFirstList[job] = list;
+    }
+    jobs.jobFirstList[jobCount] = draw_data->CmdListsCount;
+    if(jobs.compactVertices && jobs.packedVertices.size() < jobCount)
+    {
+        jobs.packedVertices.resize(jobCount);
+    }
+
+    if(jobCount > 1)
+    {
+        rendererData->parallelFor(jobCount,ImGui_Slag_UploadJob,&jobs,rendererData->parallelForUserData);
+    }
+    else
+    {
+        ImGui_Slag_UploadJob(0,&jobs);
+    }
+}
+void ImGui_Slag_RenderDrawData(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_ViewportData* rendererViewportData, uint8_t currentIndex, uint32_t frameBufferWidth, uint32_t frameBufferHeight);
+void ImGui_ImplSlag_RenderDrawData(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer)
+{
+    auto rendererViewportData = static_cast<ImGui_ImplSlag_ViewportData*>(draw_data->OwnerViewport->RendererUserData);
+    ImGui_Slag_RenderDrawData(draw_data,commandBuffer,rendererViewportData,rendererViewportData->swapchain->currentFrameIndex(),rendererViewportData->swapchain->width(),rendererViewportData->swapchain->height());
+}
+//records draw_data with the upload buffers of rendererViewportData, using frame slot currentIndex, into a frameBufferWidth x frameBufferHeight target
+void ImGui_Slag_RenderDrawData(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_ViewportData* rendererViewportData, uint8_t currentIndex, uint32_t frameBufferWidth, uint32_t frameBufferHeight)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_RenderDrawData");
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    auto shader = ImGui_Slag_CurrentShaderPipeline(rendererData);
+    if(draw_data->TotalVtxCount > 0)
+    {
+        if(rendererViewportData->lastFrameIndex != currentIndex || rendererViewportData->lastImGuiFrame != ImGui::GetFrameCount())
+        {
+            rendererViewportData->vertexBuffer.beginFrame(currentIndex);
+            rendererViewportData->indexBuffer.beginFrame(currentIndex);
+            rendererViewportData->indirectBuffer.beginFrame(currentIndex);
+            rendererViewportData->lastFrameIndex = currentIndex;
+            rendererViewportData->lastImGuiFrame = ImGui::GetFrameCount();
+        }
+        //sub allocate this frame's data out of the ring buffers, lists that are resident don't need any
+        ImGui_Slag_UpdateResidentLists(rendererData,rendererViewportData,draw_data);
+        size_t vertexBufferSize = 0;
+        size_t indexBufferSize = 0;
+        ImGui_Slag_PlanListSources(rendererData,rendererViewportData,draw_data,vertexBufferSize,indexBufferSize);
+        auto previousVertexBuffer = rendererViewportData->vertexBuffer.buffer;
+        auto previousIndexBuffer = rendererViewportData->indexBuffer.buffer;
+        size_t vertexBufferOffset = rendererViewportData->vertexBuffer.allocate(vertexBufferSize,16);
+        size_t indexBufferOffset = rendererViewportData->indexBuffer.allocate(indexBufferSize,16);
+        //copy draw data into buffers
+        auto vertexBuffer = rendererViewportData->vertexBuffer.buffer;
+        auto indexBuffer = rendererViewportData->indexBuffer.buffer;
+        rendererViewportData->frameStats.viewportsRendered++;
+        rendererViewportData->frameStats.bufferAllocations += (vertexBuffer != previousVertexBuffer) + (indexBuffer != previousIndexBuffer);
+        ImGui_Slag_UploadDrawLists(rendererData,rendererViewportData,draw_data,vertexBuffer,vertexBufferOffset,vertexBufferSize,indexBuffer,indexBufferOffset);
+        IMGUI_IMPL_SLAG_TRACE_SCOPE("record draw data");
+        auto& sources = rendererViewportData->listSources;
+        //in bindless mode every draw command is written to the indirect buffer once recording is done, the gpu doesn't read it until submission
+        slag::Buffer* indirectBuffer = nullptr;
+        size_t indirectBufferOffset = 0;
+        ImGui_ImplSlag_IndirectBatch indirectBatch;
+        if(rendererData->bindless)
+        {
+            size_t commandCount = 0;
+            for(int i=0; i<draw_data->CmdListsCount; i++)
+            {
+                commandCount += draw_data->CmdLists[i]->CmdBuffer.Size;
+            }
+            if(rendererViewportData->partialRedraw)
+            {
+                commandCount *= rendererViewportData->damageRects.Size;
+            }
+            auto previousIndirectBuffer = rendererViewportData->indirectBuffer.buffer;
+            indirectBufferOffset = rendererViewportData->indirectBuffer.allocate(commandCount*sizeof(ImGui_ImplSlag_IndirectDrawCommand),16);
+            indirectBuffer = rendererViewportData->indirectBuffer.buffer;
+            rendererViewportData->frameStats.bufferAllocations += indirectBuffer != previousIndirectBuffer;
+            rendererViewportData->indirectCommands.clear();
+        }
+
+        ImGuiID viewportId = draw_data->OwnerViewport ? draw_data->OwnerViewport->ID : 0;
+        uint32_t viewportQuery;
+        bool viewportTimed = ImGui_Slag_BeginTimestamp(rendererData,commandBuffer,viewportId,0,viewportQuery);
+        ImGui_ImplSlag_BoundState boundState;
+        ImGui_ImplSlag_SetupRenderState(draw_data,shader,commandBuffer,sources[0].vertexBuffer,sources[0].vertexBufferOffset,sources[0].vertexBufferSize,sources[0].indexBuffer,sources[0].indexBufferOffset,frameBufferWidth,frameBufferHeight,boundState,rendererViewportData);
+        // Setup render state structure (for callbacks and custom texture bindings)
+        ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
+        ImGui_ImplSlag_RenderState render_state;
+        render_state.commandBuffer = commandBuffer;
+        render_state.shader = shader;
+        IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE = &render_state;
+        if(!IMGUI_IMPL_SLAG_RECORDING_IN_PARALLEL)
+        {
+            platform_io.Renderer_RenderState = &render_state;
+        }
+
+        // Will project scissor/clipping rectangles into framebuffer space
+        ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+        ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+        for(int i=0; i< draw_data->CmdListsCount; i++)
+        {
+            const ImDrawList* draw_list = draw_data->CmdLists[i];
+            //resident lists and uploaded lists live in different buffers
+            const ImGui_ImplSlag_ListSource& source = sources[i];
+            if(boundState.vertexBuffer != source.vertexBuffer || boundState.vertexBufferOffset != source.vertexBufferOffset ||
+               boundState.indexBuffer != source.indexBuffer || boundState.indexBufferOffset != source.indexBufferOffset)
+            {
+                ImGui_ImplSlag_FlushIndirectBatch(commandBuffer,boundState,rendererViewportData,indirectBatch,indirectBuffer,indirectBufferOffset);
+                ImGui_ImplSlag_BindBuffers(commandBuffer,boundState,rendererViewportData,source.vertexBuffer,source.vertexBufferOffset,source.vertexBufferSize,source.indexBuffer,source.indexBufferOffset);
+            }
+            size_t vertexDrawOffset = source.firstVertex;
+            size_t indexDrawOffset = source.firstIndex;
+            //the window's id is the hash of its name, lists the backend adds itself have no owner
+            uint32_t listQuery;
+            bool listTimed = rendererData->profileDrawLists && draw_list->_OwnerName && ImGui_Slag_BeginTimestamp(rendererData,commandBuffer,viewportId,ImHashStr(draw_list->_OwnerName),listQuery);
+            for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
+            {
+                const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
+                if (pcmd->UserCallback != nullptr)
+                {
+                    // User callback, registered via ImDrawList::AddCallback()
+                    // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                    ImGui_ImplSlag_FlushIndirectBatch(commandBuffer,boundState,rendererViewportData,indirectBatch,indirectBuffer,indirectBufferOffset);
+                    rendererViewportData->frameStats.callbacks++;
+                    if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                    {
+                        ImGui_ImplSlag_SetupRenderState(draw_data,shader,commandBuffer,source.vertexBuffer,source.vertexBufferOffset,source.vertexBufferSize,source.indexBuffer,source.indexBufferOffset,frameBufferWidth,frameBufferHeight,boundState,rendererViewportData);
+                    }
+                    else
+                    {
+                        ImGui_Slag_RestoreFramePool(rendererData,commandBuffer,boundState);
+                        pcmd->UserCallback(draw_list,pcmd);
+                        ImGui_Slag_ApplyUserCallback(rendererData,shader,boundState,pcmd->UserCallback);
+                    }
+                }
+                else
+                {
+                    // Project scissor/clipping rectangles into framebuffer space
+                    ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+                    ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+
+                    // Clamp to viewport as vkCmdSetScissor() won't accept values that are off bounds
+                    if (clip_min.x < 0.0f) { clip_min.x = 0.0f; }
+                    if (clip_min.y < 0.0f) { clip_min.y = 0.0f; }
+                    if (clip_max.x > frameBufferWidth) { clip_max.x = (float)frameBufferWidth; }
+                    if (clip_max.y > frameBufferHeight) { clip_max.y = (float)frameBufferHeight; }
+                    if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
+                        continue;
+
+                    //in a partial redraw the command is drawn once for each damaged area it touches, clipped to that area
+                    int drawRects = rendererViewportData->partialRedraw ? rendererViewportData->damageRects.Size : 1;
+                    for(int rect_i = 0; rect_i < drawRects; rect_i++)
+                    {
+                        ImVec2 draw_min = clip_min;
+                        ImVec2 draw_max = clip_max;
+                        if(rendererViewportData->partialRedraw)
+                        {
+                            const ImVec4& damage = rendererViewportData->damageRects[rect_i];
+                            draw_min = ImVec2(std::max(draw_min.x,damage.x),std::max(draw_min.y,damage.y));
+                            draw_max = ImVec2(std::min(draw_max.x,damage.z),std::min(draw_max.y,damage.w));
+                            if (draw_max.x <= draw_min.x || draw_max.y <= draw_min.y)
+                                continue;
+                        }
+                        // Apply scissor/clipping rectangle
+                        slag::Rectangle scissor;
+                        scissor.offset.x = (int32_t)(draw_min.x);
+                        scissor.offset.y = (int32_t)(draw_min.y);
+                        scissor.extent.width = (uint32_t)(draw_max.x - draw_min.x);
+                        scissor.extent.height = (uint32_t)(draw_max.y - draw_min.y);
+                        if(rendererData->bindless && rendererData->textureIds.count(pcmd->GetTexID()) != 0)
+                        {
+                            //queue the draw, only a change of scissor forces a new multi draw
+                            if(indirectBatch.commandCount > 0 &&
+                               (indirectBatch.scissor.offset.x != scissor.offset.x || indirectBatch.scissor.offset.y != scissor.offset.y ||
+                                indirectBatch.scissor.extent.width != scissor.extent.width || indirectBatch.scissor.extent.height != scissor.extent.height))
+                            {
+                                ImGui_ImplSlag_FlushIndirectBatch(commandBuffer,boundState,rendererViewportData,indirectBatch,indirectBuffer,indirectBufferOffset);
+                            }
+                            if(indirectBatch.commandCount == 0)
+                            {
+                                ImGui_Slag_BindBindlessArray(rendererData,draw_data,commandBuffer,boundState,rendererViewportData);
+                            }
+                            indirectBatch.scissor = scissor;
+                            indirectBatch.commandCount++;
+                            ImGui_ImplSlag_IndirectDrawCommand command;
+                            command.indexCount = pcmd->ElemCount;
+                            command.instanceCount = 1;
+                            command.firstIndex = pcmd->IdxOffset+indexDrawOffset;
+                            command.vertexOffset = pcmd->VtxOffset+vertexDrawOffset;
+                            //the slot with the channels in the top bits, it's a live registered id so it's in the array
+                            command.firstInstance = (uint32_t)(pcmd->GetTexID()-1);
+                            rendererViewportData->indirectCommands.push_back(command);
+                            rendererViewportData->frameStats.indices += pcmd->ElemCount;
+                            continue;
+                        }
+                        if(rendererData->bindless)
+                        {
+                            //anything else isn't a slot in the array, raw bundles are drawn on their own with the regular pipeline, the array is bound again once a multi draw needs it
+                            ImGui_ImplSlag_FlushIndirectBatch(commandBuffer,boundState,rendererViewportData,indirectBatch,indirectBuffer,indirectBufferOffset);
+                            assert(pcmd->GetTexID() != 0 && "Draw command has no texture");
+                            if(pcmd->GetTexID() == 0)
+                            {
+                                continue;
+                            }
+                            auto regularPipeline = ImGui_Slag_RegularShaderPipeline(rendererData);
+                            if(boundState.pipeline != regularPipeline)
+                            {
+                                ImGui_Slag_BindPipeline(rendererData,commandBuffer,regularPipeline);
+                                ImGui_ImplSlag_PushTransform(draw_data,regularPipeline,commandBuffer);
+                                boundState.pipeline = regularPipeline;
+                                boundState.channels = ImGui_ImplSlag_TextureChannels_RGBA;
+                            }
+                        }
+                        ImGui_ImplSlag_SetScissor(commandBuffer,boundState,rendererViewportData,scissor);
+
+
+                        // Bind DescriptorSet with font or user texture
+                        slag::ShaderPipeline* switchTo = nullptr;
+                        slag::DescriptorPool* bindPool = nullptr;
+                        if(!ImGui_Slag_PrepareDraw(rendererData,shader,boundState,pcmd->GetTexID(),switchTo,bindPool))
+                        {
+                            rendererViewportData->skippedCalls.descriptorBundles++;
+                        }
+                        else
+                        {
+                            if(bindPool != nullptr)
+                            {
+                                commandBuffer->bindDescriptorPool(bindPool);
+                            }
+                            if(switchTo != nullptr)
+                            {
+                                ImGui_Slag_BindPipeline(rendererData,commandBuffer,switchTo);
+                                ImGui_ImplSlag_PushTransform(draw_data,switchTo,commandBuffer);
+                            }
+                            commandBuffer->bindGraphicsDescriptorBundle(boundState.pipeline,0,*boundState.descriptorBundle);
+                            rendererViewportData->frameStats.descriptorBinds++;
+                        }
+                        // Draw
+                        commandBuffer->drawIndexed(pcmd->ElemCount,1,pcmd->IdxOffset+indexDrawOffset,pcmd->VtxOffset+vertexDrawOffset,0);
+                        rendererViewportData->frameStats.drawCalls++;
+                        rendererViewportData->frameStats.indices += pcmd->ElemCount;
+                    }
+                }
+            }
+            if(listTimed)
+            {
+                //queued indirect draws have to be recorded before the list's end timestamp
+                ImGui_ImplSlag_FlushIndirectBatch(commandBuffer,boundState,rendererViewportData,indirectBatch,indirectBuffer,indirectBufferOffset);
+                ImGui_Slag_EndTimestamp(rendererData,commandBuffer,listQuery);
+            }
+        }
+
+        ImGui_ImplSlag_FlushIndirectBatch(commandBuffer,boundState,rendererViewportData,indirectBatch,indirectBuffer,indirectBufferOffset);
+        if(viewportTimed)
+        {
+            ImGui_Slag_EndTimestamp(rendererData,commandBuffer,viewportQuery);
+        }
+        if(rendererData->bindless && !rendererViewportData->indirectCommands.empty())
+        {
+            indirectBuffer->update(indirectBufferOffset,rendererViewportData->indirectCommands.data(),rendererViewportData->indirectCommands.size()*sizeof(ImGui_ImplSlag_IndirectDrawCommand));
+        }
+
+        IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE = nullptr;
+        if(!IMGUI_IMPL_SLAG_RECORDING_IN_PARALLEL)
+        {
+            platform_io.Renderer_RenderState = nullptr;
+        }
+
+        slag::Rectangle scissor = { { 0, 0 }, { frameBufferWidth, frameBufferHeight } };
+        ImGui_ImplSlag_SetScissor(commandBuffer,boundState,rendererViewportData,scissor);
+        ImGui_Slag_RestoreFramePool(rendererData,commandBuffer,boundState);
+    }
+
+}
+void ImGui_ImplSlag_GetUploadHighWaterMark(size_t* vertexBytes, size_t* indexBytes)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    size_t vertexHighWaterMark = rendererData->vertexHighWaterMark;
+    size_t indexHighWaterMark = rendererData->indexHighWaterMark;
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    for(int i=0; i<platformIo.Viewports.Size; i++)
+    {
+        auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(platformIo.Viewports[i]->RendererUserData);
+        if(viewportData)
+        {
+            vertexHighWaterMark = std::max(vertexHighWaterMark,viewportData->vertexBuffer.highWaterMark);
+            indexHighWaterMark = std::max(indexHighWaterMark,viewportData->indexBuffer.highWaterMark);
+        }
+    }
+    for(auto renderTarget: rendererData->renderTargets)
+    {
+        vertexHighWaterMark = std::max(vertexHighWaterMark,renderTarget->vertexBuffer.highWaterMark);
+        indexHighWaterMark = std::max(indexHighWaterMark,renderTarget->indexBuffer.highWaterMark);
+    }
+    if(vertexBytes)
+    {
+        *vertexBytes = vertexHighWaterMark;
+    }
+    if(indexBytes)
+    {
+        *indexBytes = indexHighWaterMark;
+    }
+}
+ImGui_ImplSlag_SkippedCalls ImGui_ImplSlag_GetSkippedCalls()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    return rendererData->lastFrameSkippedCalls;
+}
+void ImGui_ImplSlag_SetGpuProfiler(ImGui_ImplSlag_WriteTimestamp writeTimestamp, ImGui_ImplSlag_ReadTimestamps readTimestamps, void* userData, uint32_t queryCount, double nanosecondsPerTick, bool perDrawList)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    //every query pair has a begin and an end
+    uint32_t queriesPerFrame = (queryCount/(IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1)) & ~1u;
+    assert((writeTimestamp == nullptr || (readTimestamps && queriesPerFrame > 0)) && "the gpu profiler needs both callbacks and at least two queries per frame in flight");
+    rendererData->writeTimestamp = writeTimestamp;
+    rendererData->readTimestamps = readTimestamps;
+    rendererData->timestampUserData = userData;
+    rendererData->nanosecondsPerTick = nanosecondsPerTick;
+    rendererData->profileDrawLists = perDrawList;
+    rendererData->timestampQueriesPerFrame = queriesPerFrame;
+    rendererData->timestampScopes.assign(queriesPerFrame/2*(IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1),ImGui_ImplSlag_GpuTiming());
+    rendererData->timestampTicks.assign(queriesPerFrame,0);
+    rendererData->pendingTimestampQueries.fill(0);
+    rendererData->gpuTimings.clear();
+    //timing starts with the next frame
+    rendererData->timestampsActive = false;
+}
+const ImVector<ImGui_ImplSlag_GpuTiming>& ImGui_ImplSlag_GetGpuTimings()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    return rendererData->gpuTimings;
+}
+bool ImGui_ImplSlag_EnableBindlessTextures()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(rendererData->bindless)
+    {
+        return true;
+    }
+    assert(rendererData->textures.size() == 1 && rendererData->retiringTextures.empty() && "ImGui_ImplSlag_EnableBindlessTextures must be called before any textures are added");
+    if(ImGui_Slag_Pipeline(rendererData,ImGui_ImplSlag_Pipeline_Bindless) == nullptr)
+    {
+        return false;
+    }
+    //the font was registered with a bundle during init, move it into the array instead
+    auto fontEntry = rendererData->textures.begin()->second;
+    auto fontChannels = fontEntry->channels;
+    rendererData->textures.clear();
+    ImGui_Slag_ReleaseTextureEntry(rendererData,fontEntry);
+    rendererData->bindless = true;
+    ImGui_Slag_CreateFormatPipelines(rendererData);
+    rendererData->fontsTextureId = ImGui_ImplSlag_AddTexture(rendererData->fontsTexture,rendererData->sampler,fontChannels);
+    io.Fonts->SetTexID(rendererData->fontsTextureId);
+    return true;
+}
+ImTextureID ImGui_ImplSlag_AddTexture(slag::Texture* texture, slag::Sampler* sampler, ImGui_ImplSlag_TextureChannels channels)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    auto found = rendererData->textures.find({texture,sampler});
+    if(found != rendererData->textures.end())
+    {
+        auto entry = found->second;
+        assert(entry->channels == channels && "Texture was already added with different channels");
+        if(entry->references == 0)
+        {
+            //it was removed but hasn't retired yet, bring it back
+            for(size_t i=0; i<rendererData->retiringTextures.size(); i++)
+            {
+                if(rendererData->retiringTextures[i] == entry)
+                {
+                    rendererData->retiringTextures.erase(rendererData->retiringTextures.begin()+i);
+                    break;
+                }
+            }
+            entry->destroyTexture = false;
+        }
+        entry->references++;
+        return entry->id;
+    }
+
+    auto entry = new ImGui_ImplSlag_TextureEntry();
+    entry->texture = texture;
+    entry->sampler = sampler;
+    entry->channels = channels;
+    entry->references = 1;
+    if(rendererData->bindless)
+    {
+        if(!rendererData->freeBindlessSlots.empty())
+        {
+            entry->bindlessSlot = rendererData->freeBindlessSlots.back();
+            rendererData->freeBindlessSlots.pop_back();
+            rendererData->bindlessTextures[entry->bindlessSlot] = {texture,sampler};
+        }
+        else
+        {
+            assert(rendererData->bindlessTextures.size() < IMGUI_IMPL_SLAG_BINDLESS_TEXTURE_COUNT && "Bindless texture array is full");
+            entry->bindlessSlot = rendererData->bindlessTextures.size();
+            rendererData->bindlessTextures.push_back({texture,sampler});
+            rendererData->bindlessSlotVersions.push_back(0);
+        }
+        rendererData->bindlessSlotVersions[entry->bindlessSlot] = ++rendererData->bindlessVersion;
+        //the copy of the array this frame draws with was already written in NewFrame, so the slot is written to it now unless a command buffer already binds it. The other copies, and this one once it's bound, catch up through bindlessVersion when their frame comes around
+        assert(IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE == nullptr && "Textures can't be added while draw data is being recorded");
+        if(rendererData->bindlessBundle != nullptr && !rendererData->bindlessBundleBound)
+        {
+            rendererData->bindlessBundle->setSamplerAndTexture(0,entry->bindlessSlot,texture, slag::Texture::SHADER_RESOURCE,sampler);
+            for(size_t i=0; i<rendererData->bindlessBundles.size(); i++)
+            {
+                if(rendererData->bindlessBundles[i] == rendererData->bindlessBundle && rendererData->bindlessBundleVersions[i] == rendererData->bindlessVersion-1)
+                {
+                    rendererData->bindlessBundleVersions[i] = rendererData->bindlessVersion;
+                }
+            }
+        }
+        //bindless texture ids are the slot + 1, so slot 0 is never the null id, with the channels in the top two bits for the fragment shader
+        entry->id = (ImTextureID)((entry->bindlessSlot+1) | ((uint32_t)channels << 30));
+    }
+    else
+    {
+        if((rendererData->textureChannels & (1u<<channels)) == 0)
+        {
+            rendererData->textureChannels |= 1u<<channels;
+            ImGui_Slag_CreateFormatPipelines(rendererData);
+        }
+        entry->bundle = new slag::DescriptorBundle(rendererData->textureDescriptorPool->makeBundle(rendererData->shaderPipeline->descriptorGroup(0)));
+        entry->bundle->setSamplerAndTexture(0,0,texture, slag::Texture::SHADER_RESOURCE,sampler);
+        entry->id = (ImTextureID)entry->bundle;
+    }
+    rendererData->textures[{texture,sampler}] = entry;
+    rendererData->textureIds[entry->id] = entry;
+    return entry->id;
+}
+void ImGui_ImplSlag_RemoveTexture(ImTextureID textureId, bool destroyTexture)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    auto found = rendererData->textureIds.find(textureId);
+    assert(found != rendererData->textureIds.end() && "Texture id wasn't created by ImGui_ImplSlag_AddTexture");
+    auto entry = found->second;
+    assert(entry->references > 0 && "Texture was removed more times than it was added");
+    entry->references--;
+    if(entry->references == 0)
+    {
+        entry->retireFrame = ImGui::GetFrameCount() + IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT + 1;
+        entry->destroyTexture = destroyTexture;
+        rendererData->retiringTextures.push_back(entry);
+    }
+}
+void ImGui_ImplSlag_SetJobSystem(ImGui_ImplSlag_ParallelFor parallelFor, void* userData, uint32_t maxJobs, size_t minBytesPerJob)
+{
+    IMGUI_IMPL_SLAG_PARALLEL_FOR = parallelFor;
+    IMGUI_IMPL_SLAG_PARALLEL_FOR_USER_DATA = userData;
+    IMGUI_IMPL_SLAG_MAX_UPLOAD_JOBS = maxJobs > 0 ? maxJobs : 1;
+    IMGUI_IMPL_SLAG_MIN_UPLOAD_JOB_BYTES = minBytesPerJob;
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(rendererData)
+    {
+        rendererData->parallelFor = IMGUI_IMPL_SLAG_PARALLEL_FOR;
+        rendererData->parallelForUserData = IMGUI_IMPL_SLAG_PARALLEL_FOR_USER_DATA;
+        rendererData->maxUploadJobs = IMGUI_IMPL_SLAG_MAX_UPLOAD_JOBS;
+        rendererData->minUploadJobBytes = IMGUI_IMPL_SLAG_MIN_UPLOAD_JOB_BYTES;
+    }
+}
+void ImGui_ImplSlag_SetCompactVertices(bool enabled)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    rendererData->compactVertices = enabled;
+    ImGui_Slag_CreateFormatPipelines(rendererData);
+}
+void ImGui_ImplSlag_RenderPlatformWindowsParallel(void* platformRenderArg)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_RenderPlatformWindowsParallel");
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+
+    //same order as RenderPlatformWindowsDefault, except the renderer's part of every window is recorded at once
+    auto& viewports = rendererData->parallelViewports;
+    viewports.resize(0);
+    for(int i=1; i<platformIo.Viewports.Size; i++)
+    {
+        ImGuiViewport* viewport = platformIo.Viewports[i];
+        if(viewport->Flags & ImGuiViewportFlags_IsMinimized)
+        {
+            continue;
+        }
+        if(platformIo.Platform_RenderWindow)
+        {
+            platformIo.Platform_RenderWindow(viewport,platformRenderArg);
+        }
+        auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(viewport->RendererUserData);
+        if(viewportData->swapchain->currentFrame() && !ImGui_Slag_ViewportUnchanged(rendererData,viewport))
+        {
+            ImGui_Slag_PrepareWindow(rendererData,viewport);
+            viewports.push_back(viewport);
+        }
+    }
+
+    //pipelines are created on first use, make sure that doesn't happen on several workers at once
+    ImGui_Slag_CurrentShaderPipeline(rendererData);
+    ImGui_Slag_RegularShaderPipeline(rendererData);
+    if(rendererData->parallelFor && viewports.Size > 1)
+    {
+        IMGUI_IMPL_SLAG_RECORDING_CONTEXT = ImGui::GetCurrentContext();
+        rendererData->parallelFor(viewports.Size,ImGui_Slag_RecordWindowJob,&viewports,rendererData->parallelForUserData);
+    }
+    else
+    {
+        for(int i=0; i<viewports.Size; i++)
+        {
+            ImGui_Slag_RecordWindow(viewports[i]);
+        }
+    }
+    for(int i=0; i<viewports.Size; i++)
+    {
+        ImGui_Slag_SubmitWindow(viewports[i]);
+    }
+
+    for(int i=1; i<platformIo.Viewports.Size; i++)
+    {
+        ImGuiViewport* viewport = platformIo.Viewports[i];
+        if(viewport->Flags & ImGuiViewportFlags_IsMinimized)
+        {
+            continue;
+        }
+        if(platformIo.Platform_SwapBuffers)
+        {
+            platformIo.Platform_SwapBuffers(viewport,platformRenderArg);
+        }
+        if(platformIo.Renderer_SwapBuffers)
+        {
+            platformIo.Renderer_SwapBuffers(viewport,nullptr);
+        }
+    }
+}
+ImGui_ImplSlag_RenderState* ImGui_ImplSlag_GetRenderState()
+{
+    return IMGUI_IMPL_SLAG_CURRENT_RENDER_STATE;
+}
+void ImGui_ImplSlag_SetViewportConfig(const ImGui_ImplSlag_ViewportConfig& defaultConfig, ImGui_ImplSlag_ViewportConfigCallback callback, void* userData)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    assert(defaultConfig.imageCount > 0 && defaultConfig.imageCount <= IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT && "Viewport image count must be between 1 and IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT");
+    rendererData->viewportConfig = defaultConfig;
+    rendererData->viewportConfigCallback = callback;
+    rendererData->viewportConfigUserData = userData;
+}
+void ImGui_ImplSlag_SetSkipUnchangedViewports(bool enabled)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    rendererData->skipUnchangedViewports = enabled;
+    ImGui_ImplSlag_InvalidateViewports();
+}
+bool ImGui_ImplSlag_ViewportChanged(ImGuiViewport* viewport)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    return !ImGui_Slag_ViewportUnchanged(rendererData,viewport);
+}
+void ImGui_ImplSlag_InvalidateViewports()
+{
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    for(int i=0; i<platformIo.Viewports.Size; i++)
+    {
+        auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(platformIo.Viewports[i]->RendererUserData);
+        if(viewportData)
+        {
+            viewportData->forceRedraw = true;
+            viewportData->backBufferHistory.clear();
+            //cached windows were rasterized from the old contents, they're cached again once they've stayed the same for IMGUI_IMPL_SLAG_WINDOW_CACHE_FRAMES
+            //lists already swapped for their quads this frame still draw the old texture, its removal is deferred until the frame finishes
+            for(auto& cache: viewportData->windowCaches)
+            {
+                ImGui_Slag_ReleaseWindowCacheTexture(cache.second);
+                cache.second->unchangedFrames = 0;
+            }
+        }
+    }
+}
+uint64_t ImGui_ImplSlag_GetElidedViewportFrames()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    return rendererData->elidedViewportFrames;
+}
+void ImGui_ImplSlag_SetIncrementalPresentation(bool enabled)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    rendererData->incrementalPresentation = enabled;
+    ImGui_ImplSlag_InvalidateViewports();
+}
+ImGui_ImplSlag_RenderTarget* ImGui_ImplSlag_CreateRenderTarget(uint8_t framesInFlight, size_t vertexUploadBufferSize, size_t indexUploadBufferSize)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    assert(framesInFlight > 0 && framesInFlight <= IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT && "Render target frames in flight must be between 1 and IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT");
+    auto renderTarget = new ImGui_ImplSlag_RenderTarget(framesInFlight,vertexUploadBufferSize,indexUploadBufferSize);
+    rendererData->renderTargets.push_back(renderTarget);
+    return renderTarget;
+}
+void ImGui_ImplSlag_DestroyRenderTarget(ImGui_ImplSlag_RenderTarget* renderTarget)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    auto it = std::find(rendererData->renderTargets.begin(),rendererData->renderTargets.end(),renderTarget);
+    assert(it != rendererData->renderTargets.end() && "Render target was not created by ImGui_ImplSlag_CreateRenderTarget or was already destroyed");
+    rendererData->renderTargets.erase(it);
+    rendererData->vertexHighWaterMark = std::max(rendererData->vertexHighWaterMark,renderTarget->vertexBuffer.highWaterMark);
+    rendererData->indexHighWaterMark = std::max(rendererData->indexHighWaterMark,renderTarget->indexBuffer.highWaterMark);
+    delete renderTarget;
+}
+void ImGui_ImplSlag_RenderDrawDataToTexture(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_RenderTarget* renderTarget, slag::Texture* texture, bool clear, ImVec4 clearColor)
+{
+    //every imgui frame moves on to the next set of upload buffers, renders within the same frame share them
+    if(renderTarget->lastImGuiFrame != ImGui::GetFrameCount() && renderTarget->lastImGuiFrame != -1)
+    {
+        renderTarget->targetFrameIndex = (renderTarget->targetFrameIndex+1)%renderTarget->targetFramesInFlight;
+    }
+
+    slag::Attachment attachment{.texture=texture,.layout=slag::Texture::RENDER_TARGET,.clearOnLoad=clear,.clear={.color={clearColor.x,clearColor.y,clearColor.z,clearColor.w}}};
+    commandBuffer->beginRendering(&attachment,1, nullptr,{.offset={0,0},.extent={texture->width(),texture->height()}});
+    ImGui_Slag_RenderDrawData(draw_data,commandBuffer,renderTarget,renderTarget->targetFrameIndex,texture->width(),texture->height());
+    commandBuffer->endRendering();
+}
+void ImGui_ImplSlag_SetWindowCaching(bool enabled)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(!enabled)
+    {
+        ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+        for(int i=0; i<platformIo.Viewports.Size; i++)
+        {
+            auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(platformIo.Viewports[i]->RendererUserData);
+            if(viewportData)
+            {
+                ImGui_Slag_ClearWindowCaches(viewportData);
+            }
+        }
+    }
+    rendererData->cacheWindows = enabled;
+    ImGui_Slag_CreateFormatPipelines(rendererData);
+}
+void ImGui_ImplSlag_UpdateWindowCache(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_UpdateWindowCache");
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    auto viewportData = static_cast<ImGui_ImplSlag_ViewportData*>(draw_data->OwnerViewport->RendererUserData);
+    ImGui_Slag_PlanWindowCache(rendererData,viewportData,draw_data);
+    ImGui_Slag_RasterizeWindowCache(viewportData,draw_data,commandBuffer);
+}
+void ImGui_ImplSlag_SetDrawListCaching(bool enabled, uint32_t maxVertices, uint32_t maxIndices)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    rendererData->cacheDrawLists = enabled;
+    rendererData->residentVertexCapacity = maxVertices;
+    rendererData->residentIndexCapacity = maxIndices;
+}
+ImFont* ImGui_ImplSlag_AddLazyFont(const void* fontData, size_t fontDataSize, float sizePixels, const ImWchar* lazyGlyphRanges, const ImFontConfig* fontConfig)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    assert(io.BackendRendererUserData == nullptr && "lazy fonts must be added before ImGui_ImplSlag_Init");
+    ImFontConfig config = fontConfig ? *fontConfig : ImFontConfig();
+    void* data = IM_ALLOC(fontDataSize);
+    memcpy(data,fontData,fontDataSize);
+    config.FontDataOwnedByAtlas = true;
+    ImFont* font = io.Fonts->AddFontFromMemoryTTF(data,(int)fontDataSize,sizePixels,&config,config.GlyphRanges);
+    auto lazyFont = new ImGui_ImplSlag_LazyFont();
+    lazyFont->fontData = data;
+    for(const ImWchar* range = lazyGlyphRanges; range && range[0] && range[1]; range+=2)
+    {
+        lazyFont->lazyGlyphRanges.push_back(range[0]);
+        lazyFont->lazyGlyphRanges.push_back(range[1]);
+    }
+    IMGUI_IMPL_SLAG_LAZY_FONTS.push_back(lazyFont);
+    return font;
+}
+void ImGui_ImplSlag_PushLazyFont(ImFont* font)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    ImGui::PushFont(font);
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    rendererData->openLazyTextRanges.push_back(rendererData->lazyTextRanges.size());
+    rendererData->lazyTextRanges.push_back({drawList,drawList->VtxBuffer.Size,-1});
+}
+void ImGui_ImplSlag_PopLazyFont()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    assert(!rendererData->openLazyTextRanges.empty() && "ImGui_ImplSlag_PopLazyFont without ImGui_ImplSlag_PushLazyFont");
+    auto& range = rendererData->lazyTextRanges[rendererData->openLazyTextRanges.back()];
+    rendererData->openLazyTextRanges.pop_back();
+    //vertices are only ever appended during a frame, channel splitters and new commands just index into them
+    range.vertexEnd = range.drawList->VtxBuffer.Size;
+    ImGui::PopFont();
+}
+void ImGui_ImplSlag_RequestGlyphs(ImDrawData* draw_data)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(!rendererData->fontsReady || rendererData->lazyGlyphs.empty() || draw_data == nullptr)
+    {
+        return;
+    }
+    int frame = ImGui::GetFrameCount();
+    const float atlasWidth = (float)io.Fonts->TexWidth;
+    const float atlasHeight = (float)io.Fonts->TexHeight;
+    const float cacheX = (float)rendererData->glyphCacheX;
+    const float cacheY = (float)rendererData->glyphCacheY;
+    const float cacheSize = (float)(rendererData->glyphCellColumns*rendererData->glyphCellWidth);
+    const float cacheHeight = (float)(rendererData->glyphCells.size()/rendererData->glyphCellColumns*rendererData->glyphCellHeight);
+    for(auto& range: rendererData->lazyTextRanges)
+    {
+        if(std::find(draw_data->CmdLists.begin(),draw_data->CmdLists.end(),range.drawList) == draw_data->CmdLists.end())
+        {
+            continue;
+        }
+        ImDrawList* draw_list = const_cast<ImDrawList*>(range.drawList);
+        int vertexEnd = range.vertexEnd != -1 ? range.vertexEnd : draw_list->VtxBuffer.Size;
+        for(int i=range.vertexStart; i<vertexEnd; i++)
+        {
+            ImDrawVert& vertex = draw_list->VtxBuffer[i];
+            if(vertex.uv.x < 0.0f)
+            {
+                //not resident, hidden until it's been uploaded
+                size_t glyph = (size_t)(-vertex.uv.x)-1;
+                if(glyph < rendererData->lazyGlyphs.size() && !rendererData->lazyGlyphs[glyph].requested)
+                {
+                    rendererData->lazyGlyphs[glyph].requested = true;
+                    rendererData->requestedGlyphs.push_back((int)glyph);
+                }
+                vertex.col = 0;
+                continue;
+            }
+            float x = vertex.uv.x*atlasWidth-cacheX;
+            float y = vertex.uv.y*atlasHeight-cacheY;
+            if(x >= 0.0f && y >= 0.0f && x < cacheSize && y < cacheHeight)
+            {
+                uint32_t cell = (uint32_t)y/rendererData->glyphCellHeight*rendererData->glyphCellColumns + (uint32_t)x/rendererData->glyphCellWidth;
+                rendererData->glyphCells[cell].lastUsedFrame = frame;
+            }
+        }
+    }
+}
+void ImGui_Slag_UploadFontAtlas(ImGui_ImplSlag_Data* rendererData, slag::CommandBuffer* commandBuffer)
+{
+    rendererData->fontBuildThread->join();
+    delete rendererData->fontBuildThread;
+    rendererData->fontBuildThread = nullptr;
+    //copied through a staging buffer that's freed once the frames that could be reading it have finished
+    uint32_t width = (uint32_t)rendererData->pendingFontWidth;
+    uint32_t height = (uint32_t)rendererData->pendingFontHeight;
+    size_t size = (size_t)width*height*(rendererData->pendingFontsSingleChannel ? 1 : 4);
+    rendererData->fontStagingBuffer = slag::Buffer::newBuffer(size,slag::Buffer::CPU_AND_GPU,slag::Buffer::DATA_BUFFER);
+    rendererData->fontStagingBuffer->update(0,rendererData->pendingFontPixels,size);
+    rendererData->fontStagingRetireFrame = ImGui::GetFrameCount() + IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT + 1;
+    rendererData->pendingFontAtlas->ClearTexData();
+    ImGui_Slag_ReleaseFontCache(rendererData);
+    rendererData->pendingFontPixels = nullptr;
+    rendererData->pendingFontsTexture = slag::Texture::newTexture(rendererData->pendingFontsSingleChannel ? slag::Pixels::R8_UNORM : slag::Pixels::R8G8B8A8_UNORM,width,height,1,slag::TextureUsageFlags::SAMPLED_IMAGE);
+    commandBuffer->insertBarrier(
+        slag::ImageBarrier
+            {
+                .texture=rendererData->pendingFontsTexture,
+                .oldLayout=slag::Texture::UNDEFINED,
+                .newLayout=slag::Texture::TRANSFER_DESTINATION,
+                .accessBefore=slag::BarrierAccessFlags::NONE,
+                .accessAfter=slag::BarrierAccessFlags::TRANSFER_WRITE,
+                .syncBefore=slag::PipelineStageFlags::NONE,
+                .syncAfter=slag::PipelineStageFlags::TRANSFER
+            });
+    commandBuffer->copyBufferToImage(rendererData->fontStagingBuffer,0,rendererData->pendingFontsTexture,slag::Texture::TRANSFER_DESTINATION,0,0,{.offset={0,0},.extent={width,height}});
+    commandBuffer->insertBarrier(
+        slag::ImageBarrier
+            {
+                .texture=rendererData->pendingFontsTexture,
+                .oldLayout=slag::Texture::TRANSFER_DESTINATION,
+                .newLayout=slag::Texture::SHADER_RESOURCE,
+                .accessBefore=slag::BarrierAccessFlags::TRANSFER_WRITE,
+                .accessAfter=slag::BarrierAccessFlags::SHADER_READ,
+                .syncBefore=slag::PipelineStageFlags::TRANSFER,
+                .syncAfter=slag::PipelineStageFlags::FRAGMENT_SHADER
+            });
+}
+void ImGui_ImplSlag_UpdateFontTexture(slag::CommandBuffer* commandBuffer)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_UpdateFontTexture");
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(rendererData->fontBuildThread && rendererData->fontBuildFinished.load(std::memory_order_acquire))
+    {
+        ImGui_Slag_UploadFontAtlas(rendererData,commandBuffer);
+    }
+    if(!rendererData->fontsReady || rendererData->lazyGlyphs.empty())
+    {
+        return;
+    }
+    ImGuiPlatformIO& platformIo = ImGui::GetPlatformIO();
+    for(int i=0; i<platformIo.Viewports.Size; i++)
+    {
+        ImDrawData* drawData = platformIo.Viewports[i]->DrawData;
+        if(drawData && drawData->Valid)
+        {
+            ImGui_ImplSlag_RequestGlyphs(drawData);
+        }
+    }
+    int frame = ImGui::GetFrameCount();
+    rendererData->glyphUploadBuffer->beginFrame(frame % (IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1));
+    if(rendererData->requestedGlyphs.empty())
+    {
+        return;
+    }
+
+    //empty cells first, then the least recently drawn, cells drawn this frame are never evicted
+    std::vector<int> cells;
+    for(size_t i=0; i<rendererData->glyphCells.size(); i++)
+    {
+        if(rendererData->glyphCells[i].glyph == -1 || rendererData->glyphCells[i].lastUsedFrame < frame)
+        {
+            cells.push_back((int)i);
+        }
+    }
+    size_t count = std::min(cells.size(),rendererData->requestedGlyphs.size());
+    std::partial_sort(cells.begin(),cells.begin()+count,cells.end(),[rendererData](int a, int b)
+    {
+        auto& cellA = rendererData->glyphCells[a];
+        auto& cellB = rendererData->glyphCells[b];
+        if((cellA.glyph == -1) != (cellB.glyph == -1))
+        {
+            return cellA.glyph == -1;
+        }
+        return cellA.lastUsedFrame < cellB.lastUsedFrame;
+    });
+
+    const uint32_t cellWidth = rendererData->glyphCellWidth;
+    const uint32_t cellHeight = rendererData->glyphCellHeight;
+    const uint32_t texelSize = rendererData->singleChannelFonts ? 1 : 4;
+    const size_t cellBytes = cellWidth*cellHeight*texelSize;
+    std::vector<unsigned char> pixels(cellBytes*count,0);
+    std::vector<unsigned char> coverage(cellWidth*cellHeight);
+    const float atlasWidth = (float)io.Fonts->TexWidth;
+    const float atlasHeight = (float)io.Fonts->TexHeight;
+    for(size_t i=0; i<count; i++)
+    {
+        int glyphIndex = rendererData->requestedGlyphs[i];
+        int cellIndex = cells[i];
+        auto& cell = rendererData->glyphCells[cellIndex];
+        if(cell.glyph != -1)
+        {
+            auto& evicted = rendererData->lazyGlyphs[cell.glyph];
+            ImFontGlyph& evictedGlyph = evicted.font->Glyphs[evicted.glyph];
+            evictedGlyph.U0 = evictedGlyph.V0 = evictedGlyph.U1 = evictedGlyph.V1 = -(float)(cell.glyph+1);
+            evicted.cell = -1;
+        }
+        auto& lazyGlyph = rendererData->lazyGlyphs[glyphIndex];
+        auto lazyFont = IMGUI_IMPL_SLAG_LAZY_FONTS[lazyGlyph.lazyFont];
+        int x0,y0,x1,y1;
+        stbtt_GetGlyphBitmapBox(&lazyFont->fontInfo,lazyGlyph.fontGlyph,lazyFont->scale,lazyFont->scale,&x0,&y0,&x1,&y1);
+        int glyphWidth = std::min(x1-x0,(int)cellWidth-1);
+        int glyphHeight = std::min(y1-y0,(int)cellHeight-1);
+        stbtt_MakeGlyphBitmap(&lazyFont->fontInfo,coverage.data(),glyphWidth,glyphHeight,(int)cellWidth,lazyFont->scale,lazyFont->scale,lazyGlyph.fontGlyph);
+        //same as the baked glyphs, just coverage in an R8 atlas, otherwise white with coverage in alpha. The rest of the cell is cleared
+        unsigned char* cellPixels = pixels.data()+i*cellBytes;
+        for(int y=0; y<glyphHeight; y++)
+        {
+            for(int x=0; x<glyphWidth; x++)
+            {
+                unsigned char* pixel = cellPixels+(y*cellWidth+x)*texelSize;
+                pixel[texelSize-1] = coverage[y*cellWidth+x];
+                if(texelSize == 4)
+                {
+                    pixel[0] = pixel[1] = pixel[2] = 255;
+                }
+            }
+        }
+        uint32_t cellX = rendererData->glyphCacheX+(cellIndex%rendererData->glyphCellColumns)*cellWidth;
+        uint32_t cellY = rendererData->glyphCacheY+(cellIndex/rendererData->glyphCellColumns)*cellHeight;
+        ImFontGlyph& glyph = lazyGlyph.font->Glyphs[lazyGlyph.glyph];
+        glyph.U0 = cellX/atlasWidth;
+        glyph.V0 = cellY/atlasHeight;
+        glyph.U1 = (cellX+glyphWidth)/atlasWidth;
+        glyph.V1 = (cellY+glyphHeight)/atlasHeight;
+        lazyGlyph.cell = cellIndex;
+        cell.glyph = glyphIndex;
+        cell.lastUsedFrame = frame;
+    }
+    //glyphs that didn't fit are asked for again the next time they're drawn
+    for(auto glyphIndex: rendererData->requestedGlyphs)
+    {
+        rendererData->lazyGlyphs[glyphIndex].requested = false;
+    }
+    rendererData->requestedGlyphs.clear();
+    if(count == 0)
+    {
+        return;
+    }
+
+    size_t offset = rendererData->glyphUploadBuffer->allocate(pixels.size(),4);
+    slag::Buffer* uploadBuffer = rendererData->glyphUploadBuffer->buffer;
+    uploadBuffer->update(offset,pixels.data(),pixels.size());
+    commandBuffer->insertBarrier(
+        slag::ImageBarrier
+            {
+                .texture=rendererData->fontsTexture,
+                .oldLayout=slag::Texture::SHADER_RESOURCE,
+                .newLayout=slag::Texture::TRANSFER_DESTINATION,
+                .accessBefore=slag::BarrierAccessFlags::SHADER_READ,
+                .accessAfter=slag::BarrierAccessFlags::TRANSFER_WRITE,
+                .syncBefore=slag::PipelineStageFlags::FRAGMENT_SHADER,
+                .syncAfter=slag::PipelineStageFlags::TRANSFER
+            });
+    for(size_t i=0; i<count; i++)
+    {
+        int cellIndex = cells[i];
+        int32_t cellX = (int32_t)(rendererData->glyphCacheX+(cellIndex%rendererData->glyphCellColumns)*cellWidth);
+        int32_t cellY = (int32_t)(rendererData->glyphCacheY+(cellIndex/rendererData->glyphCellColumns)*cellHeight);
+        commandBuffer->copyBufferToImage(uploadBuffer,offset+i*cellBytes,rendererData->fontsTexture,slag::Texture::TRANSFER_DESTINATION,0,0,{.offset={cellX,cellY},.extent={cellWidth,cellHeight}});
+    }
+    commandBuffer->insertBarrier(
+        slag::ImageBarrier
+            {
+                .texture=rendererData->fontsTexture,
+                .oldLayout=slag::Texture::TRANSFER_DESTINATION,
+                .newLayout=slag::Texture::SHADER_RESOURCE,
+                .accessBefore=slag::BarrierAccessFlags::TRANSFER_WRITE,
+                .accessAfter=slag::BarrierAccessFlags::SHADER_READ,
+                .syncBefore=slag::PipelineStageFlags::TRANSFER,
+                .syncAfter=slag::PipelineStageFlags::FRAGMENT_SHADER
+            });
+}
+ImFont* ImGui_ImplSlag_AddSdfFont(const void* fontData, size_t fontDataSize, float sizePixels, const ImWchar* glyphRanges, const ImFontConfig* fontConfig)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    assert(io.BackendRendererUserData == nullptr && "sdf fonts must be added before ImGui_ImplSlag_Init");
+    //only the space is baked normally, it has no outline to make a field from
+    static const ImWchar spaceRange[] = {0x20,0x20,0};
+    ImFontConfig config = fontConfig ? *fontConfig : ImFontConfig();
+    void* data = IM_ALLOC(fontDataSize);
+    memcpy(data,fontData,fontDataSize);
+    config.FontDataOwnedByAtlas = true;
+    ImFont* font = io.Fonts->AddFontFromMemoryTTF(data,(int)fontDataSize,sizePixels,&config,spaceRange);
+    auto bytes = static_cast<const unsigned char*>(data);
+    stbtt_fontinfo fontInfo;
+    if(!stbtt_InitFont(&fontInfo,bytes,stbtt_GetFontOffsetForIndex(bytes,config.FontNo)))
+    {
+        return font;
+    }
+    float scale = stbtt_ScaleForPixelHeight(&fontInfo,sizePixels);
+    int ascent, descent, lineGap;
+    stbtt_GetFontVMetrics(&fontInfo,&ascent,&descent,&lineGap);
+    //rounded the same way the atlas builder places its glyphs, so the fields line up with the baked space
+    const float offsetX = config.GlyphOffset.x;
+    const float offsetY = config.GlyphOffset.y + (float)(int)(std::ceil(ascent*scale) + 0.5f);
+    for(const ImWchar* range = glyphRanges ? glyphRanges : io.Fonts->GetGlyphRangesDefault(); range[0] && range[1]; range+=2)
+    {
+        for(unsigned int codepoint = range[0]; codepoint <= range[1]; codepoint++)
+        {
+            int glyph = stbtt_FindGlyphIndex(&fontInfo,(int)codepoint);
+            if(glyph == 0)
+            {
+                continue;
+            }
+            ImGui_ImplSlag_SdfGlyph sdfGlyph;
+            int offsetLeft, offsetTop;
+            sdfGlyph.distances = stbtt_GetGlyphSDF(&fontInfo,scale,glyph,IMGUI_IMPL_SLAG_SDF_SPREAD,128,128.0f/IMGUI_IMPL_SLAG_SDF_SPREAD,&sdfGlyph.width,&sdfGlyph.height,&offsetLeft,&offsetTop);
+            if(sdfGlyph.distances == nullptr)
+            {
+                continue;
+            }
+            int advance, leftSideBearing;
+            stbtt_GetGlyphHMetrics(&fontInfo,glyph,&advance,&leftSideBearing);
+            sdfGlyph.rect = io.Fonts->AddCustomRectFontGlyph(font,(ImWchar)codepoint,sdfGlyph.width,sdfGlyph.height,advance*scale,ImVec2(offsetLeft+offsetX,offsetTop+offsetY));
+            IMGUI_IMPL_SLAG_SDF_GLYPHS.push_back(sdfGlyph);
+        }
+    }
+    return font;
+}
+void ImGui_ImplSlag_PushSdfText(ImDrawList* drawList)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    //made here rather than in the callback, viewports can be recorded on several threads at once
+    rendererData->sdfText = true;
+    ImGui_Slag_CreateFormatPipelines(rendererData);
+    (drawList ? drawList : ImGui::GetWindowDrawList())->AddCallback(ImGui_Slag_UseSdfPipeline,nullptr);
+}
+void ImGui_ImplSlag_PopSdfText(ImDrawList* drawList)
+{
+    (drawList ? drawList : ImGui::GetWindowDrawList())->AddCallback(ImDrawCallback_ResetRenderState,nullptr);
+}
+bool ImGui_ImplSlag_SetAsyncFontBuild(bool enabled)
+{
+    assert(ImGui::GetIO().BackendRendererUserData == nullptr && "the font build mode must be set before ImGui_ImplSlag_Init");
+    //the atlas build allocates through IM_ALLOC, which reports every allocation to the current context. A worker only stays off the main thread's context if each thread has its own, or if imgui's debug tools that track allocations are compiled out
+#if defined(GImGui) || defined(IMGUI_DISABLE_DEBUG_TOOLS)
+    IMGUI_IMPL_SLAG_ASYNC_FONT_BUILD = enabled;
+    return true;
+#else
+    IMGUI_IMPL_SLAG_ASYNC_FONT_BUILD = false;
+    return !enabled;
+#endif
+}
+bool ImGui_ImplSlag_FontsReady()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    return rendererData->fontsReady;
+}
+void ImGui_ImplSlag_SetFontAtlasCache(const char* directory)
+{
+    assert(ImGui::GetIO().BackendRendererUserData == nullptr && "the font atlas cache must be set before ImGui_ImplSlag_Init");
+    IMGUI_IMPL_SLAG_FONT_CACHE_DIRECTORY = directory ? directory : "";
+}
+void ImGui_ImplSlag_SetPipelineCacheData(const void* data, size_t size)
+{
+    assert(ImGui::GetIO().BackendRendererUserData == nullptr && "pipeline cache data must be set before ImGui_ImplSlag_Init");
+    IMGUI_IMPL_SLAG_PREWARM_PIPELINES = 0;
+    ImGui_ImplSlag_PipelineCacheData cacheData;
+    if(data == nullptr || size != sizeof(cacheData))
+    {
+        return;
+    }
+    memcpy(&cacheData,data,sizeof(cacheData));
+    if(cacheData.magic == IM_COL32('I','S','P','C') && cacheData.version == IMGUI_IMPL_SLAG_PIPELINE_CACHE_VERSION)
+    {
+        IMGUI_IMPL_SLAG_PREWARM_PIPELINES = cacheData.pipelines & ((1u<<ImGui_ImplSlag_Pipeline_COUNT)-1);
+    }
+}
+size_t ImGui_ImplSlag_GetPipelineCacheData(void* data, size_t size)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    ImGui_ImplSlag_PipelineCacheData cacheData{IM_COL32('I','S','P','C'),IMGUI_IMPL_SLAG_PIPELINE_CACHE_VERSION,rendererData->usedPipelines.load(std::memory_order_relaxed)};
+    if(data && size >= sizeof(cacheData))
+    {
+        memcpy(data,&cacheData,sizeof(cacheData));
+    }
+    return sizeof(cacheData);
+}
+ImGui_ImplSlag_FrameStats ImGui_ImplSlag_GetFrameStats()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    return rendererData->lastFrameStats;
+}
+//counters plotted by the frame stats window, byte counts are shown in KiB
+const char* IMGUI_IMPL_SLAG_FRAME_STATS_COUNTERS[] = {"draw calls","indices","vertex KiB uploaded","index KiB uploaded","buffer allocations","descriptor binds","scissor changes","callbacks","viewports rendered","gpu memory KiB"};
+float ImGui_Slag_FrameStatsCounter(const ImGui_ImplSlag_FrameStats& stats, int counter)
+{
+    switch(counter)
+    {
+        case 0: return (float)stats.drawCalls;
+        case 1: return (float)stats.indices;
+        case 2: return (float)stats.vertexBytesUploaded/1024.0f;
+        case 3: return (float)stats.indexBytesUploaded/1024.0f;
+        case 4: return (float)stats.bufferAllocations;
+        case 5: return (float)stats.descriptorBinds;
+        case 6: return (float)stats.scissorChanges;
+        case 7: return (float)stats.callbacks;
+        case 8: return (float)stats.viewportsRendered;
+        default: return (float)stats.gpuMemoryBytes/1024.0f;
+    }
+}
+//what ImGui::PlotLines reads a counter's history through
+struct ImGui_ImplSlag_FrameStatsPlot
+{
+    ImGui_ImplSlag_Data* rendererData;
+    int counter;
+};
+float ImGui_Slag_FrameStatsPlotValue(void* data, int index)
+{
+    auto plot = static_cast<ImGui_ImplSlag_FrameStatsPlot*>(data);
+    return ImGui_Slag_FrameStatsCounter(plot->rendererData->frameStatsHistory[index],plot->counter);
+}
+void ImGui_ImplSlag_ShowFrameStatsWindow(bool* open)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(io.BackendRendererUserData);
+    if(!ImGui::Begin("Slag Frame Stats",open))
+    {
+        ImGui::End();
+        return;
+    }
+    for(int counter=0; counter<IM_ARRAYSIZE(IMGUI_IMPL_SLAG_FRAME_STATS_COUNTERS); counter++)
+    {
+        ImGui_ImplSlag_FrameStatsPlot plot{rendererData,counter};
+        //the range grows with the largest value in the history so spikes stay on the graph
+        float largest = 0.0f;
+        for(auto& stats: rendererData->frameStatsHistory)
+        {
+            largest = std::max(largest,ImGui_Slag_FrameStatsCounter(stats,counter));
+        }
+        char overlay[64];
+        snprintf(overlay,sizeof(overlay),"%.0f (max %.0f)",ImGui_Slag_FrameStatsCounter(rendererData->lastFrameStats,counter),largest);
+        ImGui::PlotLines(IMGUI_IMPL_SLAG_FRAME_STATS_COUNTERS[counter],ImGui_Slag_FrameStatsPlotValue,&plot,IMGUI_IMPL_SLAG_FRAME_STATS_HISTORY,rendererData->frameStatsHistoryOffset,overlay,0.0f,largest > 0.0f ? largest : 1.0f,ImVec2(0.0f,40.0f));
+    }
+    ImGui::End();
+}
+bool ImGui_ImplSlag_WriteTrace(const char* path)
+{
+#ifdef IMGUI_IMPL_SLAG_TRACE
+    FILE* file = fopen(path,"wb");
+    if(file == nullptr)
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(IMGUI_IMPL_SLAG_TRACE_MUTEX);
+    //timestamps are written relative to the oldest scope still recorded, in microseconds
+    //threads can keep tracing while this runs, events are only written if their slot wasn't reused before they were copied out
+    uint64_t origin = UINT64_MAX;
+    ImGui_ImplSlag_TraceEvent event;
+    for(auto& buffer: IMGUI_IMPL_SLAG_TRACE_BUFFERS)
+    {
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        for(uint64_t i = count > IMGUI_IMPL_SLAG_TRACE_EVENTS ? count-IMGUI_IMPL_SLAG_TRACE_EVENTS : 0; i<count; i++)
+        {
+            if(ImGui_Slag_ReadTraceEvent(buffer.get(),i,event))
+            {
+                origin = std::min(origin,event.start);
+            }
+        }
+    }
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[",file);
+    bool first = true;
+    for(auto& buffer: IMGUI_IMPL_SLAG_TRACE_BUFFERS)
+    {
+        fprintf(file,"%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",first ? "" : ",",buffer->threadIndex,buffer->threadIndex);
+        first = false;
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        for(uint64_t i = count > IMGUI_IMPL_SLAG_TRACE_EVENTS ? count-IMGUI_IMPL_SLAG_TRACE_EVENTS : 0; i<count; i++)
+        {
+            if(!ImGui_Slag_ReadTraceEvent(buffer.get(),i,event))
+            {
+                continue;
+            }
+            fputs(",\n{\"name\":\"",file);
+            for(const char* c = event.name; *c; c++)
+            {
+                if(*c == '"' || *c == '\\')
+                {
+                    fputc('\\',file);
+                }
+                fputc(*c,file);
+            }
+            fprintf(file,"\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",buffer->threadIndex,(event.start-origin)/1000.0,event.duration/1000.0);
+        }
+    }
+    fputs("\n]}\n",file);
+    return fclose(file) == 0;
+#else
+    (void)path;
+    return false;
+#endif
+}
+//bump whenever the layout of capture files changes
+#define IMGUI_IMPL_SLAG_CAPTURE_VERSION 2
+//capture files start with this header, everything after it is 8 byte aligned
+struct ImGui_ImplSlag_CaptureHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexSize;
+    uint32_t indexSize;
+    //offset of the frame table, written when the capture ends: frame count, texture handle count, then the offset of each frame
+    uint64_t frameTable;
+};
+//followed by listCount offsets of the frame's lists, which may have been written for an earlier frame
+struct ImGui_ImplSlag_CaptureFrameHeader
+{
+    ImVec2 displayPos;
+    ImVec2 displaySize;
+    ImVec2 framebufferScale;
+    uint32_t listCount;
+    uint32_t padding;
+};
+//followed by the list's vertices, indices and commands, each padded to 8 bytes
+struct ImGui_ImplSlag_CaptureList
+{
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t commandCount;
+    uint32_t flags;
+};
+//what a captured command does, the backend's own callbacks are stored as kinds as their addresses change between builds
+enum ImGui_ImplSlag_CaptureCommandKind
+{
+    ImGui_ImplSlag_CaptureCommandKind_Draw = 0,
+    ImGui_ImplSlag_CaptureCommandKind_ResetRenderState,
+    ImGui_ImplSlag_CaptureCommandKind_UseCompositePipeline,
+    ImGui_ImplSlag_CaptureCommandKind_UseSdfPipeline,
+    ImGui_ImplSlag_CaptureCommandKind_COUNT,
+};
+struct ImGui_ImplSlag_CaptureCommand
+{
+    ImVec4 clipRect;
+    uint32_t texture;
+    uint32_t vertexOffset;
+    uint32_t indexOffset;
+    uint32_t elementCount;
+    uint32_t kind;
+};
+//callback a command kind is replayed with, nullptr for draws
+const ImDrawCallback IMGUI_IMPL_SLAG_CAPTURE_CALLBACKS[ImGui_ImplSlag_CaptureCommandKind_COUNT] = {nullptr,ImDrawCallback_ResetRenderState,ImGui_Slag_UseCompositePipeline,ImGui_Slag_UseSdfPipeline};
+struct ImGui_ImplSlag_Capture
+{
+    FILE* file = nullptr;
+    uint64_t offset = 0;
+    bool failed = false;
+    std::unordered_map<ImTextureID,uint32_t> textureHandles;
+    uint32_t textureCount = 1;
+    //where each list of the previous frame and this one was written, keyed by hash
+    std::unordered_map<uint64_t,uint64_t> previousLists;
+    std::unordered_map<uint64_t,uint64_t> currentLists;
+    std::vector<uint64_t> frames;
+    std::vector<uint64_t> listOffsets;
+    ImVector<ImGui_ImplSlag_CaptureCommand> commands;
+};
+struct ImGui_ImplSlag_Replay
+{
+    ImGui_ImplSlag_MappedFile* file = nullptr;
+    uint32_t frameCount = 0;
+    uint64_t frameTable = 0;
+    std::vector<ImTextureID> textures;
+    ImDrawData drawData;
+    //lists the draw data points to, reused by every frame
+    ImVector<ImDrawList*> lists;
+};
+//writes size bytes and pads them to 8
+void ImGui_Slag_CaptureWrite(ImGui_ImplSlag_Capture* capture, const void* data, size_t size)
+{
+    static const unsigned char zeros[8] = {};
+    size_t padding = (8 - size % 8) % 8;
+    if((size > 0 && fwrite(data,1,size,capture->file) != size) || (padding > 0 && fwrite(zeros,1,padding,capture->file) != padding))
+    {
+        capture->failed = true;
+    }
+    capture->offset += size + padding;
+}
+ImGui_ImplSlag_Capture* ImGui_ImplSlag_BeginCapture(const char* path)
+{
+    FILE* file = fopen(path,"wb");
+    if(file == nullptr)
+    {
+        return nullptr;
+    }
+    auto capture = new ImGui_ImplSlag_Capture();
+    capture->file = file;
+    ImGui_ImplSlag_CaptureHeader header{IM_COL32('I','M','D','C'),IMGUI_IMPL_SLAG_CAPTURE_VERSION,sizeof(ImDrawVert),sizeof(ImDrawIdx),0};
+    ImGui_Slag_CaptureWrite(capture,&header,sizeof(header));
+    return capture;
+}
+bool ImGui_ImplSlag_CaptureFrame(ImGui_ImplSlag_Capture* capture, ImDrawData* draw_data, int* droppedCallbacks)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_CaptureFrame");
+    ImTextureID fontsTexture = ImGui::GetIO().Fonts->TexID;
+    int dropped = 0;
+    capture->listOffsets.clear();
+    capture->currentLists.clear();
+    for(int i=0; i<draw_data->CmdListsCount; i++)
+    {
+        const ImDrawList* drawList = draw_data->CmdLists[i];
+        auto& commands = capture->commands;
+        commands.resize(0);
+        for(int j=0; j<drawList->CmdBuffer.Size; j++)
+        {
+            const ImDrawCmd& cmd = drawList->CmdBuffer[j];
+            auto kind = std::find(std::begin(IMGUI_IMPL_SLAG_CAPTURE_CALLBACKS),std::end(IMGUI_IMPL_SLAG_CAPTURE_CALLBACKS),cmd.UserCallback);
+            if(kind == std::end(IMGUI_IMPL_SLAG_CAPTURE_CALLBACKS))
+            {
+                //the application's own callbacks can't be replayed
+                dropped++;
+                continue;
+            }
+            ImGui_ImplSlag_CaptureCommand command{};
+            command.clipRect = cmd.ClipRect;
+            command.vertexOffset = cmd.VtxOffset;
+            command.indexOffset = cmd.IdxOffset;
+            command.elementCount = cmd.ElemCount;
+            command.kind = (uint32_t)(kind - std::begin(IMGUI_IMPL_SLAG_CAPTURE_CALLBACKS));
+            if(cmd.GetTexID() != fontsTexture)
+            {
+                auto handle = capture->textureHandles.try_emplace(cmd.GetTexID(),capture->textureCount);
+                if(handle.second)
+                {
+                    capture->textureCount++;
+                }
+                command.texture = handle.first->second;
+            }
+            commands.push_back(command);
+        }
+        uint64_t hash = ImGui_Slag_HashBytes(drawList->VtxBuffer.Data,drawList->VtxBuffer.size_in_bytes(),0xcbf29ce484222325ull);
+        hash = ImGui_Slag_HashBytes(drawList->IdxBuffer.Data,drawList->IdxBuffer.size_in_bytes(),hash);
+        hash = ImGui_Slag_HashBytes(commands.Data,commands.size_in_bytes(),hash);
+        hash = ImGui_Slag_HashBytes(&drawList->Flags,sizeof(drawList->Flags),hash);
+        //unchanged since the previous frame, point at the copy already in the file
+        auto previous = capture->previousLists.find(hash);
+        if(previous != capture->previousLists.end())
+        {
+            capture->listOffsets.push_back(previous->second);
+            capture->currentLists[hash] = previous->second;
+            continue;
+        }
+        capture->listOffsets.push_back(capture->offset);
+        capture->currentLists[hash] = capture->offset;
+        ImGui_ImplSlag_CaptureList list{(uint32_t)drawList->VtxBuffer.Size,(uint32_t)drawList->IdxBuffer.Size,(uint32_t)commands.Size,(uint32_t)drawList->Flags};
+        ImGui_Slag_CaptureWrite(capture,&list,sizeof(list));
+        ImGui_Slag_CaptureWrite(capture,drawList->VtxBuffer.Data,drawList->VtxBuffer.size_in_bytes());
+        ImGui_Slag_CaptureWrite(capture,drawList->IdxBuffer.Data,drawList->IdxBuffer.size_in_bytes());
+        ImGui_Slag_CaptureWrite(capture,commands.Data,commands.size_in_bytes());
+    }
+    std::swap(capture->previousLists,capture->currentLists);
+    capture->frames.push_back(capture->offset);
+    ImGui_ImplSlag_CaptureFrameHeader frame{draw_data->DisplayPos,draw_data->DisplaySize,draw_data->FramebufferScale,(uint32_t)capture->listOffsets.size(),0};
+    ImGui_Slag_CaptureWrite(capture,&frame,sizeof(frame));
+    ImGui_Slag_CaptureWrite(capture,capture->listOffsets.data(),capture->listOffsets.size()*sizeof(uint64_t));
+    if(droppedCallbacks)
+    {
+        *droppedCallbacks = dropped;
+    }
+    return !capture->failed;
+}
+bool ImGui_ImplSlag_EndCapture(ImGui_ImplSlag_Capture* capture)
+{
+    uint64_t frameTable = capture->offset;
+    uint32_t counts[2] = {(uint32_t)capture->frames.size(),capture->textureCount};
+    ImGui_Slag_CaptureWrite(capture,counts,sizeof(counts));
+    ImGui_Slag_CaptureWrite(capture,capture->frames.data(),capture->frames.size()*sizeof(uint64_t));
+    //the header is patched last, so a capture that was never ended isn't mistaken for a complete one
+    if(fseek(capture->file,offsetof(ImGui_ImplSlag_CaptureHeader,frameTable),SEEK_SET) != 0 || fwrite(&frameTable,sizeof(frameTable),1,capture->file) != 1)
+    {
+        capture->failed = true;
+    }
+    bool written = fclose(capture->file) == 0 && !capture->failed;
+    delete capture;
+    return written;
+}
+ImGui_ImplSlag_Replay* ImGui_ImplSlag_OpenReplay(const char* path)
+{
+    ImGui_ImplSlag_MappedFile* file = ImGui_Slag_MapFile(path);
+    if(file == nullptr)
+    {
+        return nullptr;
+    }
+    ImGui_ImplSlag_CaptureHeader header;
+    uint32_t counts[2];
+    if(file->size < sizeof(header) ||
+       (memcpy(&header,file->data,sizeof(header)), header.magic != IM_COL32('I','M','D','C')) ||
+       header.version != IMGUI_IMPL_SLAG_CAPTURE_VERSION || header.vertexSize != sizeof(ImDrawVert) || header.indexSize != sizeof(ImDrawIdx) ||
+       header.frameTable == 0 || header.frameTable > file->size - sizeof(counts) ||
+       (memcpy(counts,file->data+header.frameTable,sizeof(counts)), (file->size - header.frameTable - sizeof(counts))/sizeof(uint64_t) < counts[0]))
+    {
+        ImGui_Slag_UnmapFile(file);
+        return nullptr;
+    }
+    auto replay = new ImGui_ImplSlag_Replay();
+    replay->file = file;
+    replay->frameCount = counts[0];
+    replay->frameTable = header.frameTable + sizeof(counts);
+    replay->textures.resize(counts[1],0);
+    return replay;
+}
+int ImGui_ImplSlag_GetReplayFrameCount(ImGui_ImplSlag_Replay* replay)
+{
+    return (int)replay->frameCount;
+}
+void ImGui_ImplSlag_SetReplayTexture(ImGui_ImplSlag_Replay* replay, uint32_t handle, ImTextureID textureId)
+{
+    if(handle >= replay->textures.size())
+    {
+        replay->textures.resize(handle+1,0);
+    }
+    replay->textures[handle] = textureId;
+}
+ImDrawData* ImGui_ImplSlag_ReplayFrame(ImGui_ImplSlag_Replay* replay, int frame, ImGuiViewport* viewport)
+{
+    IMGUI_IMPL_SLAG_TRACE_SCOPE("ImGui_ImplSlag_ReplayFrame");
+    assert(frame >= 0 && frame < (int)replay->frameCount && "Replay frame out of range");
+    const unsigned char* data = replay->file->data;
+    size_t size = replay->file->size;
+    uint64_t frameOffset;
+    memcpy(&frameOffset,data+replay->frameTable+frame*sizeof(uint64_t),sizeof(frameOffset));
+    ImGui_ImplSlag_CaptureFrameHeader frameHeader;
+    if(frameOffset > size - sizeof(frameHeader))
+    {
+        return nullptr;
+    }
+    memcpy(&frameHeader,data+frameOffset,sizeof(frameHeader));
+    uint64_t listTable = frameOffset + sizeof(frameHeader);
+    if((size - listTable)/sizeof(uint64_t) < frameHeader.listCount)
+    {
+        return nullptr;
+    }
+
+    ImDrawData& drawData = replay->drawData;
+    drawData.Clear();
+    auto rendererData = static_cast<ImGui_ImplSlag_Data*>(ImGui::GetIO().BackendRendererUserData);
+    ImTextureID fontsTexture = ImGui::GetIO().Fonts->TexID;
+    while(replay->lists.Size < (int)frameHeader.listCount)
+    {
+        replay->lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+    }
+    for(uint32_t i=0; i<frameHeader.listCount; i++)
+    {
+        uint64_t listOffset;
+        memcpy(&listOffset,data+listTable+i*sizeof(uint64_t),sizeof(listOffset));
+        ImGui_ImplSlag_CaptureList list;
+        if(listOffset > size - sizeof(list))
+        {
+            return nullptr;
+        }
+        memcpy(&list,data+listOffset,sizeof(list));
+        uint64_t vertexBytes = (uint64_t)list.vertexCount*sizeof(ImDrawVert);
+        uint64_t indexBytes = (uint64_t)list.indexCount*sizeof(ImDrawIdx);
+        uint64_t commandBytes = (uint64_t)list.commandCount*sizeof(ImGui_ImplSlag_CaptureCommand);
+        uint64_t vertices = listOffset + ((sizeof(list)+7)&~7ull);
+        uint64_t indices = vertices + ((vertexBytes+7)&~7ull);
+        uint64_t commands = indices + ((indexBytes+7)&~7ull);
+        if(commands + commandBytes > size)
+        {
+            return nullptr;
+        }
+        ImDrawList* drawList = replay->lists[i];
+        drawList->Flags = (ImDrawListFlags)list.flags;
+        drawList->VtxBuffer.resize((int)list.vertexCount);
+        memcpy(drawList->VtxBuffer.Data,data+vertices,vertexBytes);
+        drawList->IdxBuffer.resize((int)list.indexCount);
+        memcpy(drawList->IdxBuffer.Data,data+indices,indexBytes);
+        drawList->CmdBuffer.resize((int)list.commandCount);
+        int commandCount = 0;
+        for(uint32_t j=0; j<list.commandCount; j++)
+        {
+            ImGui_ImplSlag_CaptureCommand command;
+            memcpy(&command,data+commands+j*sizeof(command),sizeof(command));
+            //a damaged capture mustn't make the gpu read outside the list's buffers
+            if(command.kind >= ImGui_ImplSlag_CaptureCommandKind_COUNT)
+            {
+                return nullptr;
+            }
+            if(command.kind == ImGui_ImplSlag_CaptureCommandKind_Draw && command.elementCount > 0)
+            {
+                if((uint64_t)command.indexOffset+command.elementCount > list.indexCount || command.vertexOffset >= list.vertexCount)
+                {
+                    return nullptr;
+                }
+                for(uint32_t k=0; k<command.elementCount; k++)
+                {
+                    if((uint64_t)command.vertexOffset+drawList->IdxBuffer[command.indexOffset+k] >= list.vertexCount)
+                    {
+                        return nullptr;
+                    }
+                }
+            }
+            ImDrawCallback callback = IMGUI_IMPL_SLAG_CAPTURE_CALLBACKS[command.kind];
+            //window caching and sdf text pipelines are only made once this run uses them, without them what follows is drawn with the regular pipeline
+            if(callback && callback != ImDrawCallback_ResetRenderState && ImGui_Slag_InternalCallbackPipeline(rendererData,callback) == nullptr)
+            {
+                continue;
+            }
+            ImDrawCmd& cmd = drawList->CmdBuffer[commandCount++];
+            cmd = ImDrawCmd();
+            cmd.ClipRect = command.clipRect;
+            cmd.TextureId = command.texture < replay->textures.size() && replay->textures[command.texture] ? replay->textures[command.texture] : fontsTexture;
+            cmd.VtxOffset = command.vertexOffset;
+            cmd.IdxOffset = command.indexOffset;
+            cmd.ElemCount = command.elementCount;
+            cmd.UserCallback = callback;
+        }
+        drawList->CmdBuffer.resize(commandCount);
+        drawData.CmdLists.push_back(drawList);
+        drawData.CmdListsCount++;
+        drawData.TotalVtxCount += drawList->VtxBuffer.Size;
+        drawData.TotalIdxCount += drawList->IdxBuffer.Size;
+    }
+    drawData.Valid = true;
+    drawData.DisplayPos = frameHeader.displayPos;
+    drawData.DisplaySize = frameHeader.displaySize;
+    drawData.FramebufferScale = frameHeader.framebufferScale;
+    drawData.OwnerViewport = viewport ? viewport : ImGui::GetMainViewport();
+    return &drawData;
+}
+void ImGui_ImplSlag_CloseReplay(ImGui_ImplSlag_Replay* replay)
+{
+    for(auto drawList: replay->lists)
+    {
+        IM_DELETE(drawList);
+    }
+    ImGui_Slag_UnmapFile(replay->file);
+    delete replay;
 }
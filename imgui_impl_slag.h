@@ -22,53 +22,616 @@
 #include <slag/SlagLib.h>
 #include "imgui.h"
 #include <array>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+//number of gpu state calls that were skipped because the state was already bound
+struct ImGui_ImplSlag_SkippedCalls
+{
+    uint32_t scissors = 0;
+    uint32_t descriptorBundles = 0;
+    uint32_t vertexBuffers = 0;
+    uint32_t indexBuffers = 0;
+};
+
+//work the backend did recording the last complete frame, summed over every viewport and render target
+struct ImGui_ImplSlag_FrameStats
+{
+    uint32_t drawCalls = 0;
+    uint32_t indices = 0;
+    //bytes copied into the upload and persistent buffers
+    uint64_t vertexBytesUploaded = 0;
+    uint64_t indexBytesUploaded = 0;
+    //upload, indirect and persistent buffers created or replaced by a bigger one
+    uint32_t bufferAllocations = 0;
+    uint32_t descriptorBinds = 0;
+    uint32_t scissorChanges = 0;
+    uint32_t callbacks = 0;
+    //draw data recorded, including into render targets and the window cache
+    uint32_t viewportsRendered = 0;
+    //gpu memory held by the backend's own buffers and textures at the end of the frame, not summed
+    uint64_t gpuMemoryBytes = 0;
+};
+
+//frames of history the frame stats window plots
+#define IMGUI_IMPL_SLAG_FRAME_STATS_HISTORY 120
+
+//cpu timeline of frame phases, define IMGUI_IMPL_SLAG_TRACE (cmake option SLAG_IMGUI_BACKEND_TRACE) to record IMGUI_IMPL_SLAG_TRACE_SCOPE, otherwise it compiles to nothing
+//each thread records into a buffer of its own without locking, and keeps its newest IMGUI_IMPL_SLAG_TRACE_EVENTS scopes. Names aren't copied, use string literals
+//a thread's buffer is passed on to the next thread that starts tracing once it exits, so short lived threads don't each hold one
+#define IMGUI_IMPL_SLAG_TRACE_EVENTS 65536
+#ifdef IMGUI_IMPL_SLAG_TRACE
+struct ImGui_ImplSlag_TraceScope
+{
+    explicit ImGui_ImplSlag_TraceScope(const char* scopeName);
+    ~ImGui_ImplSlag_TraceScope();
+    const char* name;
+    uint64_t start;
+};
+#define IMGUI_IMPL_SLAG_TRACE_CONCAT_(a,b) a##b
+#define IMGUI_IMPL_SLAG_TRACE_CONCAT(a,b) IMGUI_IMPL_SLAG_TRACE_CONCAT_(a,b)
+#define IMGUI_IMPL_SLAG_TRACE_SCOPE(name) ImGui_ImplSlag_TraceScope IMGUI_IMPL_SLAG_TRACE_CONCAT(imguiSlagTraceScope,__LINE__)(name)
+#else
+#define IMGUI_IMPL_SLAG_TRACE_SCOPE(name) ((void)0)
+#endif
+
+//number of textures the bindless descriptor array holds, must match the array in the bindless fragment shader
+#define IMGUI_IMPL_SLAG_BINDLESS_TEXTURE_COUNT 1024
+
+//how many frames the cpu can get ahead of the gpu, anything the gpu might still be reading is kept alive one frame longer than this
+#define IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT 3
+
+//swapchain settings for a secondary viewport's window
+//slag keeps one frame in flight per back buffer, so imageCount is also how many frames the window can have in flight, and can't exceed IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT
+struct ImGui_ImplSlag_ViewportConfig
+{
+    size_t imageCount = 3;
+    slag::Swapchain::PresentMode presentMode = slag::Swapchain::MAILBOX;
+};
+//picks the swapchain settings for a viewport as its window is created, return defaultConfig to keep the defaults
+typedef ImGui_ImplSlag_ViewportConfig (*ImGui_ImplSlag_ViewportConfigCallback)(ImGuiViewport* viewport, const ImGui_ImplSlag_ViewportConfig& defaultConfig, void* userData);
+
+//how a texture's channels become the color it's drawn with, single channel (R8) textures only have red
+enum ImGui_ImplSlag_TextureChannels
+{
+    ImGui_ImplSlag_TextureChannels_RGBA = 0,
+    //red is coverage, drawn as white with that alpha like the font atlas
+    ImGui_ImplSlag_TextureChannels_Alpha = 1,
+    //red is brightness, drawn as opaque gray
+    ImGui_ImplSlag_TextureChannels_Grayscale = 2,
+};
+
+//every pipeline the backend draws with, all for the back buffer format given to ImGui_ImplSlag_Init
+enum ImGui_ImplSlag_Pipeline
+{
+    ImGui_ImplSlag_Pipeline_Default = 0,
+    ImGui_ImplSlag_Pipeline_Compact,
+    ImGui_ImplSlag_Pipeline_Bindless,
+    ImGui_ImplSlag_Pipeline_CompactBindless,
+    ImGui_ImplSlag_Pipeline_Alpha,
+    ImGui_ImplSlag_Pipeline_CompactAlpha,
+    ImGui_ImplSlag_Pipeline_Grayscale,
+    ImGui_ImplSlag_Pipeline_CompactGrayscale,
+    ImGui_ImplSlag_Pipeline_Sdf,
+    ImGui_ImplSlag_Pipeline_CompactSdf,
+    ImGui_ImplSlag_Pipeline_BindlessSdf,
+    ImGui_ImplSlag_Pipeline_CompactBindlessSdf,
+    ImGui_ImplSlag_Pipeline_Composite,
+    ImGui_ImplSlag_Pipeline_CompactComposite,
+    ImGui_ImplSlag_Pipeline_COUNT
+};
+
+//a texture registered through ImGui_ImplSlag_AddTexture
+struct ImGui_ImplSlag_TextureEntry
+{
+    slag::Texture* texture = nullptr;
+    slag::Sampler* sampler = nullptr;
+    ImGui_ImplSlag_TextureChannels channels = ImGui_ImplSlag_TextureChannels_RGBA;
+    //bundle the texture is drawn with, null in bindless mode
+    slag::DescriptorBundle* bundle = nullptr;
+    //slot in the bindless array, only used in bindless mode
+    uint32_t bindlessSlot = 0;
+    ImTextureID id = 0;
+    uint32_t references = 0;
+    //once removed, the imgui frame after which the gpu can't be using it anymore
+    int retireFrame = 0;
+    bool destroyTexture = false;
+};
+
+//what's currently bound on the command buffer being recorded, so binding the same thing again can be skipped
+struct ImGui_ImplSlag_BoundState
+{
+    //pipeline descriptors are bound with, differs from the draw data's while single channel textures or the backend's own callbacks are drawn
+    slag::ShaderPipeline* pipeline = nullptr;
+    slag::DescriptorBundle* descriptorBundle = nullptr;
+    //pool bundles are bound from, null while it's whatever the application had bound
+    slag::DescriptorPool* descriptorPool = nullptr;
+    //channels of the textures the bound pipeline draws
+    ImGui_ImplSlag_TextureChannels channels = ImGui_ImplSlag_TextureChannels_RGBA;
+    //set after user callbacks, whatever pipeline they bound is kept until the render state is reset
+    bool pipelinePinned = false;
+    //pipeline multi draws of the bindless array go back to once raw bundles were drawn with the regular one
+    slag::ShaderPipeline* arrayPipeline = nullptr;
+    bool hasScissor = false;
+    slag::Rectangle scissor{};
+    slag::Buffer* vertexBuffer = nullptr;
+    size_t vertexBufferOffset = 0;
+    slag::Buffer* indexBuffer = nullptr;
+    size_t indexBufferOffset = 0;
+    //user callbacks can bind anything, so nothing we previously bound can be trusted afterwards
+    void invalidate()
+    {
+        *this = ImGui_ImplSlag_BoundState();
+    }
+    //the render state was set up again with basePipeline bound and nothing else
+    void reset(slag::ShaderPipeline* basePipeline)
+    {
+        *this = ImGui_ImplSlag_BoundState();
+        pipeline = basePipeline;
+        arrayPipeline = basePipeline;
+    }
+};
+
+//layout of an indexed indirect draw as the gpu reads it
+struct ImGui_ImplSlag_IndirectDrawCommand
+{
+    uint32_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    //slot of the texture in the bindless array
+    uint32_t firstInstance;
+};
+
+//how many steps per pixel compact vertex positions have, positions are stored as 16 bit signed fixed point relative to DisplayPos, so this trades precision for range (4 gives quarter pixels within +-8191 pixels)
+#define IMGUI_IMPL_SLAG_COMPACT_POSITION_SCALE 4.0f
+
+//12 byte vertex used in compact vertex mode, uvs are 16 bit unorm so they're clamped to 0-1
+struct ImGui_ImplSlag_CompactVert
+{
+    //x in the low 16 bits, y in the high
+    uint32_t pos;
+    uint32_t uv;
+    uint32_t col;
+};
+
+//runs job(jobIndex, jobData) for every jobIndex in [0, jobCount) on whatever threads it likes, and only returns once all of them have finished
+typedef void (*ImGui_ImplSlag_ParallelFor)(uint32_t jobCount, void (*job)(uint32_t jobIndex, void* jobData), void* jobData, void* userData);
+
+//writes a gpu timestamp into slot query of the application's timestamp query pool once the gpu gets to this point in commandBuffer. Called inside render passes, and from worker threads while viewports are recorded in parallel
+typedef void (*ImGui_ImplSlag_WriteTimestamp)(slag::CommandBuffer* commandBuffer, uint32_t query, void* userData);
+//copies the timestamps in slots [firstQuery, firstQuery+queryCount) into ticks without waiting, returns false if the gpu hasn't written all of them yet. After returning true the slots are written again in a later frame, reset them here if the api needs that
+typedef bool (*ImGui_ImplSlag_ReadTimestamps)(uint32_t firstQuery, uint32_t queryCount, uint64_t* ticks, void* userData);
+
+//gpu time spent drawing a viewport, or one window's draw list in it
+struct ImGui_ImplSlag_GpuTiming
+{
+    ImGuiID viewportId = 0;
+    //ID of the window the draw list belongs to, 0 for the whole viewport
+    ImGuiID windowId = 0;
+    float milliseconds = 0.0f;
+};
+
+//the draw lists of one upload and where each of them goes
+struct ImGui_ImplSlag_UploadJobs
+{
+    ImDrawData* drawData = nullptr;
+    //vertices are packed into ImGui_ImplSlag_CompactVert before being copied
+    bool compactVertices = false;
+    //buffer and byte offset every draw list is copied to, lists that are already resident have no buffers
+    std::vector<slag::Buffer*> vertexBuffers;
+    std::vector<slag::Buffer*> indexBuffers;
+    std::vector<size_t> vertexOffsets;
+    std::vector<size_t> indexOffsets;
+    //bytes copied before each draw list, with one extra entry for the end
+    std::vector<size_t> uploadedBytes;
+    //first draw list each job copies, with one extra entry for the end
+    std::vector<int> jobFirstList;
+    //scratch space each job packs compact vertices into
+    std::vector<std::vector<ImGui_ImplSlag_CompactVert>> packedVertices;
+};
+
+//a persistent buffer sub allocated in whole elements, freed ranges are only reused once the gpu can't be reading them anymore
+struct ImGui_ImplSlag_ResidentBuffer
+{
+    ImGui_ImplSlag_ResidentBuffer()=delete;
+    ImGui_ImplSlag_ResidentBuffer(uint32_t elementCapacity, size_t elementSize, slag::Buffer::Usage usage);
+    ~ImGui_ImplSlag_ResidentBuffer();
+    //returns false when there isn't a big enough free range
+    bool allocate(uint32_t count, uint32_t& first);
+    void free(uint32_t first, uint32_t count, int retireFrame);
+    //makes ranges retired by imgui frame frame available again
+    void collect(int frame);
+    slag::Buffer* buffer = nullptr;
+    uint32_t capacity = 0;
+    //first element and element count, sorted by first element
+    std::vector<std::pair<uint32_t,uint32_t>> freeRanges;
+    std::vector<std::pair<std::pair<uint32_t,uint32_t>,int>> retiringRanges;
+};
+
+//a draw list being tracked for residency, and where it lives once resident
+struct ImGui_ImplSlag_ResidentList
+{
+    uint64_t hash = 0;
+    int unchangedFrames = 0;
+    int lastSeenFrame = 0;
+    bool resident = false;
+    bool needsUpload = false;
+    uint32_t firstVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+
+//buffers a draw list's draws read from this frame, and the element its data starts at in them
+struct ImGui_ImplSlag_ListSource
+{
+    slag::Buffer* vertexBuffer = nullptr;
+    size_t vertexBufferOffset = 0;
+    size_t vertexBufferSize = 0;
+    slag::Buffer* indexBuffer = nullptr;
+    size_t indexBufferOffset = 0;
+    uint32_t firstVertex = 0;
+    uint32_t firstIndex = 0;
+};
+
+//what a single draw command put on screen, bounds are in framebuffer pixels
+struct ImGui_ImplSlag_DrawSignature
+{
+    uint64_t hash = 0;
+    ImVec4 bounds;
+};
+
+//draw commands of the last frame rendered into one back buffer, used to work out what changed since
+struct ImGui_ImplSlag_BackBufferHistory
+{
+    ImVector<ImGui_ImplSlag_DrawSignature> signatures;
+    uint64_t textureVersion = 0;
+    bool valid = false;
+};
+
+//a draw list that stopped changing, drawn from a texture instead of from its geometry
+struct ImGui_ImplSlag_WindowCache
+{
+    uint64_t hash = 0;
+    //imgui frames in a row the list has hashed the same, and the last frame it was drawn at all
+    int unchangedFrames = 0;
+    int lastSeenFrame = 0;
+    //framebuffer pixels the list covers
+    ImVec4 bounds;
+    //holds the list premultiplied, null until the list has been unchanged long enough
+    slag::Texture* texture = nullptr;
+    ImTextureID textureId = 0;
+    bool needsRasterizing = false;
+    //single quad drawing the texture, drawn in place of the list
+    ImDrawList* compositeList = nullptr;
+    ~ImGui_ImplSlag_WindowCache()
+    {
+        if(compositeList)
+        {
+            IM_DELETE(compositeList);
+        }
+    }
+};
+
+//imgui frames a draw list has to stay the same for before it's cached
+#define IMGUI_IMPL_SLAG_WINDOW_CACHE_FRAMES 8
+
+//most separate damaged areas redrawn per frame, more are merged into one
+#define IMGUI_IMPL_SLAG_MAX_DAMAGE_RECTS 8
+//fraction of the window that can be damaged before it's cheaper to just redraw all of it
+#define IMGUI_IMPL_SLAG_MAX_DAMAGE_AREA 0.6f
+
+//width and height in pixels of the font atlas region that glyphs of lazy fonts are rasterized into
+#define IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE 1024
+
+//a glyph of a lazy font, only rasterized into the glyph cache once it's drawn
+struct ImGui_ImplSlag_LazyGlyph
+{
+    ImFont* font = nullptr;
+    //index into font->Glyphs, and the glyph's index in the font file
+    int glyph = 0;
+    int fontGlyph = 0;
+    //index into the lazy fonts it's rasterized from
+    int lazyFont = 0;
+    //glyph cache cell holding it, -1 while it isn't resident
+    int cell = -1;
+    bool requested = false;
+};
+
+//vertices of a draw list added between ImGui_ImplSlag_PushLazyFont and ImGui_ImplSlag_PopLazyFont, the only ones checked for lazy glyphs. vertexEnd is -1 until the pop
+struct ImGui_ImplSlag_LazyTextRange
+{
+    const ImDrawList* drawList = nullptr;
+    int vertexStart = 0;
+    int vertexEnd = -1;
+};
+
+//a cell of the glyph cache, and the last imgui frame the glyph in it was drawn
+struct ImGui_ImplSlag_GlyphCell
+{
+    int glyph = -1;
+    int lastUsedFrame = -1;
+};
+
+//pixels the signed distance field of an sdf font glyph reaches past its edge, the field has about this many pixels of falloff to antialias and scale with
+#define IMGUI_IMPL_SLAG_SDF_SPREAD 4
+
+struct ImGui_ImplSlag_ViewportData;
+struct ImGui_ImplSlag_RingBuffer;
+struct ImGui_ImplSlag_MappedFile;
 
 struct ImGui_ImplSlag_Data
 {
     slag::ShaderPipeline* shaderPipeline = nullptr;
+    //bits of the pipelines this run has bound to draw with, see ImGui_ImplSlag_GetPipelineCacheData. Set by whichever thread records the draw
+    std::atomic<uint32_t> usedPipelines{0};
+    //bits of the pipelines a previous run used, pipelineThread creates them before they're first needed
+    uint32_t prewarmPipelines = 0;
+    std::thread* pipelineThread = nullptr;
+    //guards the two below, which pipelineThread fills in as it goes
+    std::mutex pipelineMutex;
+    std::condition_variable pipelineCreated;
+    uint32_t prewarmedPipelines = 0;
+    std::array<slag::ShaderPipeline*,ImGui_ImplSlag_Pipeline_COUNT> prewarmed{};
     slag::Sampler* sampler = nullptr;
     slag::DescriptorPool* descriptorPool = nullptr;
     slag::PlatformData platformData;
     slag::Pixels::Format backBufferFormat = slag::Pixels::UNDEFINED;
     //dear imgui managed resources
     slag::Texture* fontsTexture = nullptr;
-    slag::DescriptorBundle* fontsTextureBundle=nullptr;
+    ImTextureID fontsTextureId = 0;
+    //where the glyph cache is in the font atlas and the size of its cells, every cell fits the largest glyph of any lazy font
+    uint32_t glyphCacheX = 0;
+    uint32_t glyphCacheY = 0;
+    uint32_t glyphCellWidth = 0;
+    uint32_t glyphCellHeight = 0;
+    uint32_t glyphCellColumns = 0;
+    //every glyph of the lazy glyph ranges, the cells they're cached in and glyphs that were drawn while not resident
+    std::vector<ImGui_ImplSlag_LazyGlyph> lazyGlyphs;
+    std::vector<ImGui_ImplSlag_GlyphCell> glyphCells;
+    std::vector<int> requestedGlyphs;
+    //text drawn in lazy fonts this frame, and the ranges that haven't been popped yet
+    std::vector<ImGui_ImplSlag_LazyTextRange> lazyTextRanges;
+    std::vector<size_t> openLazyTextRanges;
+    //staging memory newly rasterized cells are copied into the atlas from
+    ImGui_ImplSlag_RingBuffer* glyphUploadBuffer = nullptr;
+    //whether the application's fonts are built and uploaded, only false while they're being built asynchronously
+    bool fontsReady = false;
+    //asynchronous font build, the application's atlas and default font are put aside while frames use the fallback atlas
+    std::thread* fontBuildThread = nullptr;
+    std::atomic<bool> fontBuildFinished{false};
+    ImFontAtlas* pendingFontAtlas = nullptr;
+    ImFont* pendingFontDefault = nullptr;
+    ImFontAtlas* fallbackFontAtlas = nullptr;
+    //what the worker built, and the texture it's been copied into until it's swapped in at the next ImGui_ImplSlag_NewFrame
+    unsigned char* pendingFontPixels = nullptr;
+    int pendingFontWidth = 0;
+    int pendingFontHeight = 0;
+    bool pendingFontsSingleChannel = false;
+    slag::Texture* pendingFontsTexture = nullptr;
+    //buffer the atlas was copied from, and the imgui frame it can be freed at
+    slag::Buffer* fontStagingBuffer = nullptr;
+    int fontStagingRetireFrame = 0;
+    //font atlas cache file the font pixels were loaded from, mapped until they've been uploaded
+    ImGui_ImplSlag_MappedFile* fontCacheFile = nullptr;
+    //persistent descriptors for every registered texture, keyed by texture and sampler
+    slag::DescriptorPool* textureDescriptorPool = nullptr;
+    std::map<std::pair<slag::Texture*,slag::Sampler*>,ImGui_ImplSlag_TextureEntry*> textures;
+    std::unordered_map<ImTextureID,ImGui_ImplSlag_TextureEntry*> textureIds;
+    //removed textures waiting for the frames that used them to finish
+    std::vector<ImGui_ImplSlag_TextureEntry*> retiringTextures;
+    //initial size of each viewport's upload ring buffers
+    size_t vertexUploadBufferSize = 0;
+    size_t indexUploadBufferSize = 0;
+    //largest amount of upload data destroyed viewports had in flight at once, live viewports track their own
+    size_t vertexHighWaterMark = 0;
+    size_t indexHighWaterMark = 0;
+    //swapchain settings for secondary viewports
+    ImGui_ImplSlag_ViewportConfig viewportConfig;
+    ImGui_ImplSlag_ViewportConfigCallback viewportConfigCallback = nullptr;
+    void* viewportConfigUserData = nullptr;
+    //redundant calls skipped by all viewports in the last full frame
+    ImGui_ImplSlag_SkippedCalls lastFrameSkippedCalls;
+    //work done by all viewports in the last full frame, and the frames before it for ImGui_ImplSlag_ShowFrameStatsWindow, oldest at frameStatsHistoryOffset
+    ImGui_ImplSlag_FrameStats lastFrameStats;
+    std::array<ImGui_ImplSlag_FrameStats,IMGUI_IMPL_SLAG_FRAME_STATS_HISTORY> frameStatsHistory{};
+    int frameStatsHistoryOffset = 0;
+    //gpu profiling, the application's query pool is split into a range of queries per frame that can be in flight, each range is read back once the gpu has written it
+    ImGui_ImplSlag_WriteTimestamp writeTimestamp = nullptr;
+    ImGui_ImplSlag_ReadTimestamps readTimestamps = nullptr;
+    void* timestampUserData = nullptr;
+    double nanosecondsPerTick = 0.0;
+    bool profileDrawLists = false;
+    uint32_t timestampQueriesPerFrame = 0;
+    //range this frame writes into, unless it's still waiting to be read back
+    int timestampRange = 0;
+    bool timestampsActive = false;
+    std::atomic<uint32_t> timestampQueriesUsed{0};
+    //what each pair of queries timed, and how many queries of each range are waiting to be read back
+    std::vector<ImGui_ImplSlag_GpuTiming> timestampScopes;
+    std::array<uint32_t,IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1> pendingTimestampQueries{};
+    std::vector<uint64_t> timestampTicks;
+    //times of the newest frame that was read back
+    ImVector<ImGui_ImplSlag_GpuTiming> gpuTimings;
+    //the font atlas is coverage only and stored as R8
+    bool singleChannelFonts = false;
+    //bits of the ImGui_ImplSlag_TextureChannels that registered textures have, and the pipelines for the single channel ones, made for each vertex format in use
+    uint32_t textureChannels = 0;
+    slag::ShaderPipeline* alphaShaderPipeline = nullptr;
+    slag::ShaderPipeline* compactAlphaShaderPipeline = nullptr;
+    slag::ShaderPipeline* grayscaleShaderPipeline = nullptr;
+    slag::ShaderPipeline* compactGrayscaleShaderPipeline = nullptr;
+    //pipelines that draw signed distance field text, made by the first ImGui_ImplSlag_PushSdfText in the current mode and vertex format
+    bool sdfText = false;
+    slag::ShaderPipeline* sdfShaderPipeline = nullptr;
+    slag::ShaderPipeline* compactSdfShaderPipeline = nullptr;
+    slag::ShaderPipeline* bindlessSdfShaderPipeline = nullptr;
+    slag::ShaderPipeline* compactBindlessSdfShaderPipeline = nullptr;
+    //bindless mode, all textures live in one descriptor array and draws are submitted indirectly
+    bool bindless = false;
+    slag::ShaderPipeline* bindlessShaderPipeline = nullptr;
+    //one copy of the array per frame that can be in flight, a copy is only rewritten when it's out of date and the frame that last used it has finished
+    std::array<slag::DescriptorBundle*,IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1> bindlessBundles{};
+    std::array<uint64_t,IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT+1> bindlessBundleVersions{};
+    uint64_t bindlessVersion = 1;
+    //the copy this frame draws with
+    slag::DescriptorBundle* bindlessBundle = nullptr;
+    //set once bindlessBundle is bound in a command buffer this frame, it can't be written to after that
+    bool bindlessBundleBound = false;
+    //texture and sampler in each slot of the bindless array, and the bindlessVersion each slot last changed in
+    std::vector<std::pair<slag::Texture*,slag::Sampler*>> bindlessTextures;
+    std::vector<uint64_t> bindlessSlotVersions;
+    //bindlessVersion the font texture, which fills every unused slot, last changed in. Copies written before it are rewritten whole
+    uint64_t bindlessFillVersion = 0;
+    std::vector<uint32_t> freeBindlessSlots;
+    //compact vertex mode, vertices are quantized to 12 bytes while uploading
+    bool compactVertices = false;
+    slag::ShaderPipeline* compactShaderPipeline = nullptr;
+    slag::ShaderPipeline* compactBindlessShaderPipeline = nullptr;
+    //optional job system to split uploads of large frames across threads
+    ImGui_ImplSlag_ParallelFor parallelFor = nullptr;
+    void* parallelForUserData = nullptr;
+    uint32_t maxUploadJobs = 1;
+    size_t minUploadJobBytes = 0;
+    //viewports being recorded by ImGui_ImplSlag_RenderPlatformWindowsParallel
+    ImVector<ImGuiViewport*> parallelViewports;
+    //offscreen render targets that haven't been destroyed yet
+    std::vector<ImGui_ImplSlag_ViewportData*> renderTargets;
+    //skip viewports whose draw data hashes the same as last frame, and how many viewport frames have been skipped
+    bool skipUnchangedViewports = false;
+    uint64_t elidedViewportFrames = 0;
+    //only redraw the parts of secondary viewports that changed since their back buffer was last drawn
+    bool incrementalPresentation = false;
+    //keep unchanged draw lists in persistent per viewport buffers instead of uploading them every frame, and the size of those buffers
+    bool cacheDrawLists = false;
+    uint32_t residentVertexCapacity = 0;
+    uint32_t residentIndexCapacity = 0;
+    //draw unchanging draw lists from textures, and the pipelines that composite them
+    bool cacheWindows = false;
+    slag::ShaderPipeline* compositeShaderPipeline = nullptr;
+    slag::ShaderPipeline* compactCompositeShaderPipeline = nullptr;
+};
+
+//a single buffer that is sub allocated each frame, allocations are retired when the frame slot that made them comes around again
+struct ImGui_ImplSlag_RingBuffer
+{
+    ImGui_ImplSlag_RingBuffer()=delete;
+    ImGui_ImplSlag_RingBuffer(size_t initialSize, slag::Buffer::Usage bufferUsage, size_t framesInFlight);
+    ~ImGui_ImplSlag_RingBuffer();
+    //retires everything the last use of this frame slot allocated, must be called before allocating for a frame
+    void beginFrame(size_t frameIndex);
+    //returns the offset into buffer where size bytes can be written, the buffer is only recreated if the frames in flight don't fit
+    size_t allocate(size_t size, size_t alignment);
+    slag::Buffer* buffer = nullptr;
+    slag::Buffer::Usage usage;
+    size_t capacity = 0;
+    //total number of bytes ever handed out, position in the buffer is head % capacity
+    uint64_t head = 0;
+    //value of head when each frame slot started allocating
+    std::vector<uint64_t> frameStarts;
+    size_t currentFrame = 0;
+    //most bytes ever in flight at once
+    size_t highWaterMark = 0;
+    size_t reallocations = 0;
+    //buffers replaced by a resize, and how many frames until the gpu is done with them
+    std::vector<std::pair<slag::Buffer*,size_t>> retiredBuffers;
 };
 
 struct ImGui_ImplSlag_ViewportData
 {
     ImGui_ImplSlag_ViewportData()=delete;
-    ImGui_ImplSlag_ViewportData(slag::Swapchain* swap, bool managedOutside)
+    ImGui_ImplSlag_ViewportData(slag::Swapchain* swap, bool managedOutside, size_t vertexBufferSize, size_t indexBufferSize):
+        vertexBuffer(vertexBufferSize,slag::Buffer::VERTEX_BUFFER,swap->backBuffers()),
+        indexBuffer(indexBufferSize,slag::Buffer::INDEX_BUFFER,swap->backBuffers()),
+        indirectBuffer(0,slag::Buffer::INDIRECT_BUFFER,swap->backBuffers())
     {
         swapchain = swap;
         outsideManaged = managedOutside;
-        drawDataArrays = std::vector<slag::Buffer*>(swapchain->backBuffers(), nullptr);
-        drawDataIndexArrays = std::vector<slag::Buffer*>(swapchain->backBuffers(), nullptr);
+    }
+    //offscreen render target, cycles through its own frame slots instead of a swapchain's
+    ImGui_ImplSlag_ViewportData(uint8_t framesInFlight, size_t vertexBufferSize, size_t indexBufferSize):
+        vertexBuffer(vertexBufferSize,slag::Buffer::VERTEX_BUFFER,framesInFlight),
+        indexBuffer(indexBufferSize,slag::Buffer::INDEX_BUFFER,framesInFlight),
+        indirectBuffer(0,slag::Buffer::INDIRECT_BUFFER,framesInFlight)
+    {
+        targetFramesInFlight = framesInFlight;
     }
     slag::Swapchain* swapchain= nullptr;
     bool outsideManaged = false;
-    std::vector<slag::Buffer*> drawDataArrays;
-    std::vector<slag::Buffer*> drawDataIndexArrays;
+    //only used by offscreen render targets
+    uint8_t targetFramesInFlight = 0;
+    uint8_t targetFrameIndex = 0;
+    ImGui_ImplSlag_RingBuffer vertexBuffer;
+    ImGui_ImplSlag_RingBuffer indexBuffer;
+    //only used in bindless mode
+    ImGui_ImplSlag_RingBuffer indirectBuffer;
+    //frame slot and imgui frame the upload buffers were last advanced for, so multiple renders in one frame don't retire each other
+    int lastFrameIndex = -1;
+    int lastImGuiFrame = -1;
+    //everything a recording writes to lives per viewport, so viewports can be recorded on different threads. ImGui's allocator isn't thread safe, so it's all in std containers
+    ImGui_ImplSlag_UploadJobs uploadJobs;
+    std::vector<ImGui_ImplSlag_ListSource> listSources;
+    //draw lists kept in persistent buffers, only for swapchain viewports, and whether they're stored compact
+    std::unordered_map<const ImDrawList*,ImGui_ImplSlag_ResidentList> residentLists;
+    ImGui_ImplSlag_ResidentBuffer* residentVertices = nullptr;
+    ImGui_ImplSlag_ResidentBuffer* residentIndices = nullptr;
+    bool residentCompact = false;
+    std::vector<ImGui_ImplSlag_IndirectDrawCommand> indirectCommands;
+    //redundant calls skipped while recording this viewport this frame, and the work that was done
+    ImGui_ImplSlag_SkippedCalls skippedCalls;
+    ImGui_ImplSlag_FrameStats frameStats;
+    //hash of the draw data last rendered, the imgui frame it was last compared on and what the comparison found
+    uint64_t drawDataHash = 0;
+    int hashedImGuiFrame = -1;
+    bool unchanged = false;
+    //set when the window needs redrawing regardless of the hash, eg. after a resize
+    bool forceRedraw = true;
+    //incremental presentation, what each back buffer holds, this frame's draw commands and the areas being redrawn
+    std::vector<ImGui_ImplSlag_BackBufferHistory> backBufferHistory;
+    ImVector<ImGui_ImplSlag_DrawSignature> signatures;
+    ImVector<ImVec4> damageRects;
+    //set on the main thread when only the damaged areas are redrawn this frame, partialRedraw while they're being recorded
+    bool redrawDamaged = false;
+    bool partialRedraw = false;
+    //clears the damaged areas before they're redrawn
+    ImDrawList* clearList = nullptr;
+    //cached draw lists drawn to this viewport, the upload buffers they're rasterized with and the imgui frame they were last updated for
+    std::unordered_map<const ImDrawList*,ImGui_ImplSlag_WindowCache*> windowCaches;
+    ImGui_ImplSlag_ViewportData* windowCacheTarget = nullptr;
+    //draw data a newly cached list is rasterized with, its list array is sized on the main thread
+    ImDrawData windowCacheDrawData;
+    int windowCacheFrame = -1;
     ~ImGui_ImplSlag_ViewportData()
     {
         if(swapchain && !outsideManaged)
         {
             delete swapchain;
         }
-        for(auto i=0; i< drawDataArrays.size(); i++)
+        if(clearList)
+        {
+            IM_DELETE(clearList);
+        }
+        if(residentVertices)
         {
-            if(drawDataArrays[i])
-            {
-                delete drawDataArrays[i];
-            }
-            if(drawDataIndexArrays[i])
-            {
-                delete drawDataIndexArrays[i];
-            }
+            delete residentVertices;
+            delete residentIndices;
         }
     }
 };
 
+//upload buffers for rendering draw data into textures instead of a swapchain
+typedef ImGui_ImplSlag_ViewportData ImGui_ImplSlag_RenderTarget;
+
+//draw data being written to, or read back from, a capture file
+struct ImGui_ImplSlag_Capture;
+struct ImGui_ImplSlag_Replay;
+
 struct ImGui_ImplSlag_RenderState
 {
     slag::CommandBuffer* commandBuffer = nullptr;
@@ -77,9 +640,125 @@ struct ImGui_ImplSlag_RenderState
 
 
 // public facing functions
-IMGUI_IMPL_API bool     ImGui_ImplSlag_Init(slag::Swapchain* mainSwapchain, slag::PlatformData platformData, void* (*extractNativeHandle)(ImGuiViewport* fromViewport), slag::Sampler* sampler, slag::Pixels::Format backBufferFormat);
+IMGUI_IMPL_API bool     ImGui_ImplSlag_Init(slag::Swapchain* mainSwapchain, slag::PlatformData platformData, void* (*extractNativeHandle)(ImGuiViewport* fromViewport), slag::Sampler* sampler, slag::Pixels::Format backBufferFormat, size_t vertexUploadBufferSize = 0, size_t indexUploadBufferSize = 0, const ImGui_ImplSlag_ViewportConfig& viewportConfig = ImGui_ImplSlag_ViewportConfig());
 IMGUI_IMPL_API void     ImGui_ImplSlag_Shutdown();
 IMGUI_IMPL_API void     ImGui_ImplSlag_NewFrame(slag::DescriptorPool* framePool);
+//registered textures are bound from the backend's own descriptor pool, framePool from ImGui_ImplSlag_NewFrame is bound again before user callbacks and on return, so it should be the pool the application had bound
 IMGUI_IMPL_API void     ImGui_ImplSlag_RenderDrawData(ImDrawData* draw_data,slag::CommandBuffer* commandBuffer);
+//most bytes of vertex/index data that have been in flight at once, pass these to ImGui_ImplSlag_Init to avoid growing the upload buffers at runtime
+IMGUI_IMPL_API void     ImGui_ImplSlag_GetUploadHighWaterMark(size_t* vertexBytes, size_t* indexBytes);
+//redundant scissor/descriptor/buffer binds skipped during the last complete frame
+IMGUI_IMPL_API ImGui_ImplSlag_SkippedCalls ImGui_ImplSlag_GetSkippedCalls();
+//draws, uploads, binds and buffer allocations of the last complete frame, and the gpu memory the backend holds
+IMGUI_IMPL_API ImGui_ImplSlag_FrameStats ImGui_ImplSlag_GetFrameStats();
+//window plotting the frame stats over the last IMGUI_IMPL_SLAG_FRAME_STATS_HISTORY frames, call between ImGui::NewFrame and ImGui::Render like ImGui::ShowDemoWindow
+IMGUI_IMPL_API void     ImGui_ImplSlag_ShowFrameStatsWindow(bool* open = nullptr);
+//writes the scopes every thread has traced to path as chrome trace json, for ui.perfetto.dev or chrome://tracing. False if IMGUI_IMPL_SLAG_TRACE isn't defined or the file can't be written
+//other threads can keep tracing while it runs, scopes they overwrite before they've been copied out are left out
+IMGUI_IMPL_API bool     ImGui_ImplSlag_WriteTrace(const char* path);
+//time how long each viewport, and with perDrawList each window, takes to draw on the gpu, using the application's timestamp query pool of queryCount slots. Pass nullptr to stop
+//queries are split between the frames that can be in flight, a frame that runs out draws the rest untimed, and a frame whose queries haven't been read back yet isn't timed at all rather than waiting on the gpu
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetGpuProfiler(ImGui_ImplSlag_WriteTimestamp writeTimestamp, ImGui_ImplSlag_ReadTimestamps readTimestamps, void* userData, uint32_t queryCount, double nanosecondsPerTick, bool perDrawList = false);
+//gpu times of the newest frame that has been read back, usually a few frames behind. Per viewport entries have a windowId of 0, valid until the next ImGui_ImplSlag_NewFrame
+IMGUI_IMPL_API const ImVector<ImGui_ImplSlag_GpuTiming>& ImGui_ImplSlag_GetGpuTimings();
+//copy draw lists into the upload buffers from several threads at once, frames smaller than minBytesPerJob per job are still copied on the calling thread. Pass nullptr to go back to serial copies
+//set before ImGui_ImplSlag_Init, the font atlas' glyphs are rasterized on it as well. With ImGui_ImplSlag_SetAsyncFontBuild that's from the font build thread, possibly while the main thread uses it too
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetJobSystem(ImGui_ImplSlag_ParallelFor parallelFor, void* userData, uint32_t maxJobs, size_t minBytesPerJob = 256*1024);
+//upload vertices as ImGui_ImplSlag_CompactVert instead of ImDrawVert, uvs outside of 0-1 and positions further than 32767/IMGUI_IMPL_SLAG_COMPACT_POSITION_SCALE pixels from the display are clamped
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetCompactVertices(bool enabled);
+//records every secondary viewport's command buffer in parallel on the job system given to ImGui_ImplSlag_SetJobSystem, then submits and presents them in order. Use instead of ImGui::RenderPlatformWindowsDefault
+//While workers record, the main thread is blocked inside this call, so the ImGui context isn't changing underneath them:
+// - safe to read: each viewport's DrawData and the ImDrawLists it points to, ImGuiIO, ImGuiPlatformIO and the frame count
+// - not safe: anything that creates, submits or modifies ImGui state (ImGui:: widget/window functions, NewFrame, Render), and ImGui_ImplSlag_AddTexture/RemoveTexture
+// - user draw callbacks run on the worker thread recording their viewport, and must find the render state through ImGui_ImplSlag_GetRenderState, platform_io.Renderer_RenderState is left null while recording in parallel. ImGui's allocator isn't thread safe, so they must not allocate through it
+IMGUI_IMPL_API void     ImGui_ImplSlag_RenderPlatformWindowsParallel(void* platformRenderArg = nullptr);
+//render state of the draw data being recorded on the calling thread, for use in draw callbacks
+IMGUI_IMPL_API ImGui_ImplSlag_RenderState* ImGui_ImplSlag_GetRenderState();
+//settings for secondary viewport windows created from now on, the callback (optional) can override them per viewport, eg. 2 image FIFO swapchains for tooltips
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetViewportConfig(const ImGui_ImplSlag_ViewportConfig& defaultConfig, ImGui_ImplSlag_ViewportConfigCallback callback = nullptr, void* userData = nullptr);
+//skip recording, submitting and presenting secondary viewports whose draw data is the same as the frame before
+//only draw lists, clip rects, texture ids and the texture set are compared, changes to a texture's contents aren't noticed, call ImGui_ImplSlag_InvalidateViewports after them. Draw lists with user callbacks are always redrawn
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetSkipUnchangedViewports(bool enabled);
+//whether the viewport's draw data differs from what was last rendered to it, always true when skipping isn't enabled. Use for the main viewport to skip its own submit and present
+IMGUI_IMPL_API bool     ImGui_ImplSlag_ViewportChanged(ImGuiViewport* viewport);
+//redraw every viewport next frame
+IMGUI_IMPL_API void     ImGui_ImplSlag_InvalidateViewports();
+//total viewport frames skipped because nothing changed
+IMGUI_IMPL_API uint64_t ImGui_ImplSlag_GetElidedViewportFrames();
+//keep secondary viewports' back buffers between frames and only clear and redraw the areas whose draw commands changed since that back buffer was last drawn to
+//like ImGui_ImplSlag_SetSkipUnchangedViewports, changes to a texture's contents aren't noticed without ImGui_ImplSlag_InvalidateViewports, and draw lists with user callbacks are always fully redrawn
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetIncrementalPresentation(bool enabled);
+//upload buffers for ImGui_ImplSlag_RenderDrawDataToTexture, each target can have framesInFlight renders in flight at once (one per imgui frame), sizes are the initial upload buffer sizes like in ImGui_ImplSlag_Init
+IMGUI_IMPL_API ImGui_ImplSlag_RenderTarget* ImGui_ImplSlag_CreateRenderTarget(uint8_t framesInFlight = IMGUI_IMPL_SLAG_MAX_FRAMES_IN_FLIGHT, size_t vertexUploadBufferSize = 0, size_t indexUploadBufferSize = 0);
+//the gpu must be done with everything rendered with the target
+IMGUI_IMPL_API void     ImGui_ImplSlag_DestroyRenderTarget(ImGui_ImplSlag_RenderTarget* renderTarget);
+//records draw_data into texture, which must be in the RENDER_TARGET layout, and is left in it. The draw data doesn't need to belong to a viewport
+//renders in different imgui frames use the target's upload buffers round robin, so the caller must make sure the render from framesInFlight imgui frames ago has finished
+IMGUI_IMPL_API void     ImGui_ImplSlag_RenderDrawDataToTexture(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer, ImGui_ImplSlag_RenderTarget* renderTarget, slag::Texture* texture, bool clear = true, ImVec4 clearColor = ImVec4(0.0f,0.0f,0.0f,0.0f));
+//draw lists (usually one per window) that stay the same for IMGUI_IMPL_SLAG_WINDOW_CACHE_FRAMES frames are rasterized into a texture once, then drawn as a single quad until they change
+//secondary viewports are handled automatically, for the main viewport call ImGui_ImplSlag_UpdateWindowCache before its render pass. Not available in bindless mode, lists with user callbacks are never cached
+//only lists drawing nothing but the font atlas are cached, a window with an ImGui::Image is always drawn as usual. Changes to the font texture's contents aren't noticed without ImGui_ImplSlag_InvalidateViewports, which also drops every cached window
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetWindowCaching(bool enabled);
+//rasterizes newly cached windows and swaps cached draw lists in draw_data for their textures. commandBuffer must have begun, but not be inside a render pass, call ImGui_ImplSlag_RenderDrawData with the same draw data afterwards
+IMGUI_IMPL_API void     ImGui_ImplSlag_UpdateWindowCache(ImDrawData* draw_data, slag::CommandBuffer* commandBuffer);
+//draw lists that are the same as the frame before are copied once into persistent per viewport buffers and drawn from there, so only lists that changed are uploaded each frame
+//capacities are in vertices and indices per viewport and are fixed once a viewport has made its buffers, lists that don't fit are uploaded every frame as usual. Offscreen render targets always upload everything
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetDrawListCaching(bool enabled, uint32_t maxVertices = 256*1024, uint32_t maxIndices = 512*1024);
+//adds a font whose lazyGlyphRanges are only rasterized the first time they're drawn, into a IMGUI_IMPL_SLAG_GLYPH_CACHE_SIZE square region of the font atlas where the least recently drawn glyphs are evicted
+//fontConfig->GlyphRanges (basic latin by default) are baked into the atlas as usual. The data is copied, must be called before ImGui_ImplSlag_Init, and the atlas can't be rebuilt afterwards. Draw its text between ImGui_ImplSlag_PushLazyFont and ImGui_ImplSlag_PopLazyFont
+IMGUI_IMPL_API ImFont*  ImGui_ImplSlag_AddLazyFont(const void* fontData, size_t fontDataSize, float sizePixels, const ImWchar* lazyGlyphRanges, const ImFontConfig* fontConfig = nullptr);
+//text in lazy fonts must be drawn between these, which push and pop the font like ImGui::PushFont/PopFont. Only the vertices added to the current window's draw list in between are checked for glyphs that aren't cached yet
+IMGUI_IMPL_API void     ImGui_ImplSlag_PushLazyFont(ImFont* font);
+IMGUI_IMPL_API void     ImGui_ImplSlag_PopLazyFont();
+//finds glyphs in draw_data's lazy font text that aren't in the glyph cache yet, they're hidden until the next ImGui_ImplSlag_UpdateFontTexture uploads them. Every viewport's draw data is checked automatically, only needed for other draw data
+//hiding them writes to the draw lists, so it has to happen after ImGui::Render and before the draw data is recorded
+IMGUI_IMPL_API void     ImGui_ImplSlag_RequestGlyphs(ImDrawData* draw_data);
+//uploads an asynchronously built atlas once it's ready, and rasterizes the glyphs drawn this frame that weren't cached and uploads just their cells. Both show up from the next frame
+//call once per frame after ImGui::Render and before any ImGui_ImplSlag_RenderDrawData when using lazy fonts or an async font build, commandBuffer must have begun, but not be inside a render pass
+IMGUI_IMPL_API void     ImGui_ImplSlag_UpdateFontTexture(slag::CommandBuffer* commandBuffer);
+//build the font atlas on a worker thread instead of blocking ImGui_ImplSlag_Init, must be called before it. Until ImGui_ImplSlag_FontsReady, frames only have imgui's default font in a small atlas of its own
+//the application's fonts and io.Fonts must not be touched while it builds, the swap happens in ImGui_ImplSlag_NewFrame after ImGui_ImplSlag_UpdateFontTexture uploaded it
+//needs GImGui to be thread local (see imgui_impl_slag_imconfig.h) or IMGUI_DISABLE_DEBUG_TOOLS, as imgui's allocator reports to the current context. Without either, enabling it returns false and the atlas is still built in ImGui_ImplSlag_Init
+IMGUI_IMPL_API bool     ImGui_ImplSlag_SetAsyncFontBuild(bool enabled);
+IMGUI_IMPL_API bool     ImGui_ImplSlag_FontsReady();
+//save built font atlases to directory, and on later runs with the same fonts, sizes, ranges and config map them from there instead of rasterizing and packing again. Must be called before ImGui_ImplSlag_Init, nullptr turns it off
+//the directory must already exist, the atlas is only built from scratch if its file is missing or out of date
+//either way the atlas' pixels are freed once uploaded, io.Fonts stays built but GetTexDataAsAlpha8/RGBA32 must not be called on it after init, as that rasterizes it again
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetFontAtlasCache(const char* directory);
+//hand over the pipeline cache data a previous run returned from ImGui_ImplSlag_GetPipelineCacheData, must be called before ImGui_ImplSlag_Init. The pipelines it lists are created on a background thread from init onwards, instead of when they're first needed
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetPipelineCacheData(const void* data, size_t size);
+//writes this run's pipeline cache data, the pipelines draws were recorded with, to data if it fits in size, and returns its size either way. Save it before ImGui_ImplSlag_Shutdown to pass to the next run
+IMGUI_IMPL_API size_t   ImGui_ImplSlag_GetPipelineCacheData(void* data, size_t size);
+//adds a font whose glyphRanges (basic latin by default) are baked into the atlas as signed distance fields, so one size stays sharp when scaled through font->Scale, SetWindowFontScale or FontGlobalScale
+//must be called before ImGui_ImplSlag_Init, the data is copied. Its text is only drawn correctly between ImGui_ImplSlag_PushSdfText and ImGui_ImplSlag_PopSdfText
+IMGUI_IMPL_API ImFont*  ImGui_ImplSlag_AddSdfFont(const void* fontData, size_t fontDataSize, float sizePixels, const ImWchar* glyphRanges = nullptr, const ImFontConfig* fontConfig = nullptr);
+//everything added to drawList (the current window's by default) until the matching pop is drawn as signed distance field text, only text in sdf fonts should be drawn in between
+IMGUI_IMPL_API void     ImGui_ImplSlag_PushSdfText(ImDrawList* drawList = nullptr);
+IMGUI_IMPL_API void     ImGui_ImplSlag_PopSdfText(ImDrawList* drawList = nullptr);
+//switch to bindless mode, must be called right after init before any textures are added or frames rendered, requires non-uniform indexing of sampled image arrays (shaderSampledImageArrayNonUniformIndexing)
+//textures are still registered through ImGui_ImplSlag_AddTexture and ImGui_ImplSlag_RemoveTexture, their ids become slots in the descriptor array instead of bundles. Any other id, such as a raw DescriptorBundle pointer, is drawn on its own outside the multi draws
+IMGUI_IMPL_API bool     ImGui_ImplSlag_EnableBindlessTextures();
+//register a texture to draw with, the returned id stays valid until removed and is what should be passed to ImGui::Image. Adding the same texture and sampler again returns the same id
+//textures can be added and removed at any point of a frame except while its draw data is being recorded, such as from draw callbacks. In bindless mode a texture added after the frame's first draw data was recorded only shows from a later frame, as the array it draws with is already bound
+//channels says how single channel textures such as R8 heatmaps are drawn, the font atlas is uploaded as R8 and drawn as ImGui_ImplSlag_TextureChannels_Alpha unless it has colored glyphs
+IMGUI_IMPL_API ImTextureID ImGui_ImplSlag_AddTexture(slag::Texture* texture, slag::Sampler* sampler, ImGui_ImplSlag_TextureChannels channels = ImGui_ImplSlag_TextureChannels_RGBA);
+//release a reference to a texture, its descriptors are freed once the frames that might use it have finished, optionally deleting the texture at the same time
+IMGUI_IMPL_API void     ImGui_ImplSlag_RemoveTexture(ImTextureID textureId, bool destroyTexture = false);
+//starts writing frames of draw data to a capture file at path, nullptr if it can't be created. Files are only readable by builds with the same ImDrawVert and ImDrawIdx
+IMGUI_IMPL_API ImGui_ImplSlag_Capture* ImGui_ImplSlag_BeginCapture(const char* path);
+//appends draw_data as the capture's next frame, draw lists that are the same as in the frame before are stored as a reference to that frame's copy
+//texture ids are stored as handles numbered in order of first use, 0 is always the font atlas. ImDrawCallback_ResetRenderState and the backend's window cache and sdf text callbacks are replayed, the application's own callbacks are left out and counted in droppedCallbacks
+IMGUI_IMPL_API bool     ImGui_ImplSlag_CaptureFrame(ImGui_ImplSlag_Capture* capture, ImDrawData* draw_data, int* droppedCallbacks = nullptr);
+//writes the frame table and closes the file, false if any of the capture couldn't be written. Frees the capture either way
+IMGUI_IMPL_API bool     ImGui_ImplSlag_EndCapture(ImGui_ImplSlag_Capture* capture);
+//maps a capture file to replay it, nullptr if it's missing, wasn't ended or was written with a different ImDrawVert or ImDrawIdx
+IMGUI_IMPL_API ImGui_ImplSlag_Replay* ImGui_ImplSlag_OpenReplay(const char* path);
+IMGUI_IMPL_API int      ImGui_ImplSlag_GetReplayFrameCount(ImGui_ImplSlag_Replay* replay);
+//texture drawn in place of a captured texture handle, handles without one are drawn with the current font atlas
+IMGUI_IMPL_API void     ImGui_ImplSlag_SetReplayTexture(ImGui_ImplSlag_Replay* replay, uint32_t handle, ImTextureID textureId);
+//rebuilds a captured frame as draw data owned by the replay, to pass to ImGui_ImplSlag_RenderDrawData or ImGui_ImplSlag_RenderDrawDataToTexture. It's drawn with the upload buffers of viewport (the main viewport by default)
+//nullptr if the frame is corrupt, otherwise valid until the next ImGui_ImplSlag_ReplayFrame or ImGui_ImplSlag_CloseReplay. Window cache and sdf text commands are left out unless this run has made their pipelines
+IMGUI_IMPL_API ImDrawData* ImGui_ImplSlag_ReplayFrame(ImGui_ImplSlag_Replay* replay, int frame, ImGuiViewport* viewport = nullptr);
+IMGUI_IMPL_API void     ImGui_ImplSlag_CloseReplay(ImGui_ImplSlag_Replay* replay);
 
 #endif //IMGUI_IMPL_SLAG_H
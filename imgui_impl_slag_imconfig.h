@@ -0,0 +1,32 @@
+//Copyright (c) 2025 Joshua Shelton
+//
+//This software is provided 'as-is', without any express or implied
+//        warranty. In no event will the authors be held liable for any damages
+//arising from the use of this software.
+//
+//Permission is granted to anyone to use this software for any purpose,
+//        including commercial applications, and to alter it and redistribute it
+//freely, subject to the following restrictions:
+//
+//1. The origin of this software must not be misrepresented; you must not
+//claim that you wrote the original software. If you use this software
+//in a product, an acknowledgment in the product documentation would be
+//appreciated but is not required.
+//2. Altered source versions must be plainly marked as such, and must not be
+//        misrepresented as being the original software.
+//3. This notice may not be removed or altered from any source distribution.
+
+
+//optional imgui config for ImGui_ImplSlag_SetAsyncFontBuild, which needs every thread to have its own current imgui context
+//imgui's allocator reports each allocation to the current context, so the font atlas built on a worker thread would otherwise report to the main thread's while it runs
+//use it with '#define IMGUI_USER_CONFIG "imgui_impl_slag_imconfig.h"' for every file that includes imgui.h, including imgui's own and the backend's (the SLAG_IMGUI_BACKEND_THREAD_LOCAL_CONTEXT CMake option does that)
+//IMGUI_USER_CONFIG replaces imconfig.h, so an application with its own config includes it from here
+
+#ifndef IMGUI_IMPL_SLAG_IMCONFIG_H
+#define IMGUI_IMPL_SLAG_IMCONFIG_H
+
+struct ImGuiContext;
+inline thread_local ImGuiContext* ImGuiSlagThreadContext = nullptr;
+#define GImGui ImGuiSlagThreadContext
+
+#endif //IMGUI_IMPL_SLAG_IMCONFIG_H
@@ -0,0 +1,22 @@
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+layout(location = 0) out vec4 fColor;
+
+//must match IMGUI_IMPL_SLAG_BINDLESS_TEXTURE_COUNT
+layout(set=0, binding=0) uniform sampler2D sTextures[1024];
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+} In;
+layout(location = 2) flat in uint TextureIndex;
+
+void main()
+{
+    //the top two bits are the texture's ImGui_ImplSlag_TextureChannels, draws in one multi draw can use different textures
+    uint channels = TextureIndex >> 30;
+    vec4 texel = texture(sTextures[nonuniformEXT(TextureIndex & 0x3FFFFFFFu)], In.UV.st);
+    if(channels == 1u) texel = vec4(1.0, 1.0, 1.0, texel.r);
+    else if(channels == 2u) texel = vec4(texel.rrr, 1.0);
+    fColor = In.Color * texel;
+}
@@ -0,0 +1,20 @@
+#version 450 core
+#extension GL_EXT_nonuniform_qualifier : require
+layout(location = 0) out vec4 fColor;
+
+//must match IMGUI_IMPL_SLAG_BINDLESS_TEXTURE_COUNT
+layout(set=0, binding=0) uniform sampler2D sTextures[1024];
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+} In;
+layout(location = 2) flat in uint TextureIndex;
+
+void main()
+{
+    vec4 texel = texture(sTextures[nonuniformEXT(TextureIndex & 0x3FFFFFFFu)], In.UV.st);
+    float distance = min(texel.r, texel.a);
+    float coverage = clamp((distance - 0.5) / max(fwidth(distance), 0.0001) + 0.5, 0.0, 1.0);
+    fColor = In.Color * vec4(1.0, 1.0, 1.0, coverage);
+}
@@ -0,0 +1,27 @@
+#version 450 core
+layout(location = 0) in uint aPos;
+layout(location = 1) in uint aUV;
+layout(location = 2) in uint aColor;
+
+layout(push_constant) uniform uPushConstant {
+        vec2 uScale;
+        vec2 uTranslate;
+} pc;
+
+out gl_PerVertex {
+        vec4 gl_Position;
+};
+
+layout(location = 0) out struct {
+    vec4 Color;
+    vec2 UV;
+} Out;
+
+void main()
+{
+    Out.Color = unpackUnorm4x8(aColor);
+    Out.UV = unpackUnorm2x16(aUV);
+    //fixed point position relative to the display, the push constants fold the fixed point scale and display offset in
+    vec2 pos = unpackSnorm2x16(aPos);
+    gl_Position = vec4(pos.x * pc.uScale.x + pc.uTranslate.x,-(pos.y * pc.uScale.y + pc.uTranslate.y) , 0, 1);
+}
@@ -0,0 +1,16 @@
+#version 450 core
+layout(location = 0) out vec4 fColor;
+
+layout(set=0, binding=0) uniform sampler2D sTexture;
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+} In;
+
+void main()
+{
+    //cached windows are premultiplied, undo it so they blend like the lists they replace
+    vec4 cached = texture(sTexture, In.UV.st);
+    fColor = In.Color * vec4(cached.rgb / max(cached.a, 1.0/255.0), cached.a);
+}
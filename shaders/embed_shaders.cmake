@@ -0,0 +1,25 @@
+#writes the compiled shaders as the byte arrays imgui_impl_slag.cpp draws with
+#usage: cmake -DSHADER_DIR=<dir with .spv files> -DSHADERS="bindless.vert;..." -DOUTPUT=<header> -P embed_shaders.cmake
+set(content "//generated from shaders/ by embed_shaders.cmake, edit the glsl and regenerate this instead\n")
+foreach(shader ${SHADERS})
+    #bindless_sdf.frag becomes DEAR_IMGUI_SLAG_IMPL_BINDLESS_SDF_FRAG_SHADER_DATA
+    string(REPLACE "." "_" name ${shader})
+    string(TOUPPER ${name} name)
+    file(READ ${SHADER_DIR}/${shader}.spv hex HEX)
+    string(APPEND content "\nconst unsigned char DEAR_IMGUI_SLAG_IMPL_${name}_SHADER_DATA[] = {\n")
+    #16 bytes a line
+    string(LENGTH ${hex} length)
+    set(offset 0)
+    while(offset LESS length)
+        string(SUBSTRING ${hex} ${offset} 32 line)
+        string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1, " line ${line})
+        math(EXPR offset "${offset}+32")
+        if(NOT offset LESS length)
+            string(REGEX REPLACE ", $" "" line ${line})
+        endif()
+        string(STRIP "${line}" line)
+        string(APPEND content "        ${line}\n")
+    endwhile()
+    string(APPEND content "};\n")
+endforeach()
+file(WRITE ${OUTPUT} "${content}")
@@ -0,0 +1,18 @@
+#version 450 core
+layout(location = 0) out vec4 fColor;
+
+layout(set=0, binding=0) uniform sampler2D sTexture;
+
+layout(location = 0) in struct {
+    vec4 Color;
+    vec2 UV;
+} In;
+
+void main()
+{
+    //distance is in red for R8 atlases and alpha for rgba ones, the other channel is 1
+    vec4 texel = texture(sTexture, In.UV.st);
+    float distance = min(texel.r, texel.a);
+    float coverage = clamp((distance - 0.5) / max(fwidth(distance), 0.0001) + 0.5, 0.0, 1.0);
+    fColor = In.Color * vec4(1.0, 1.0, 1.0, coverage);
+}
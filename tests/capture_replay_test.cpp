@@ -0,0 +1,393 @@
+//checks that captured frames replay as the draw data they were captured from, and that damaged capture files are refused instead of drawn
+#include "../imgui_impl_slag.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+void ImGui_Slag_UseCompositePipeline(const ImDrawList* drawList, const ImDrawCmd* cmd);
+
+static int failures = 0;
+
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: %s failed\n",__FILE__,__LINE__,#cond); failures++; } } while(0)
+
+//the layout imgui_impl_slag.cpp writes, so the test can find the parts of a file to damage
+struct CaptureHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexSize;
+    uint32_t indexSize;
+    uint64_t frameTable;
+};
+struct CaptureFrameHeader
+{
+    ImVec2 displayPos;
+    ImVec2 displaySize;
+    ImVec2 framebufferScale;
+    uint32_t listCount;
+    uint32_t padding;
+};
+struct CaptureList
+{
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t commandCount;
+    uint32_t flags;
+};
+struct CaptureCommand
+{
+    ImVec4 clipRect;
+    uint32_t texture;
+    uint32_t vertexOffset;
+    uint32_t indexOffset;
+    uint32_t elementCount;
+    uint32_t kind;
+};
+
+//texture ids are only compared, never drawn with
+static const ImTextureID FONT_TEXTURE = (ImTextureID)0x100;
+static const ImTextureID IMAGE_TEXTURE = (ImTextureID)0x200;
+static const ImTextureID OTHER_IMAGE_TEXTURE = (ImTextureID)0x300;
+
+static void UserCallback(const ImDrawList*, const ImDrawCmd*)
+{
+}
+
+static size_t Padded(size_t size)
+{
+    return (size+7)&~(size_t)7;
+}
+
+static std::vector<unsigned char> ReadFile(const std::string& path)
+{
+    std::vector<unsigned char> bytes;
+    FILE* file = fopen(path.c_str(),"rb");
+    if(file)
+    {
+        unsigned char buffer[4096];
+        for(size_t read = fread(buffer,1,sizeof(buffer),file); read > 0; read = fread(buffer,1,sizeof(buffer),file))
+        {
+            bytes.insert(bytes.end(),buffer,buffer+read);
+        }
+        fclose(file);
+    }
+    return bytes;
+}
+
+static void WriteFile(const std::string& path, const std::vector<unsigned char>& bytes)
+{
+    FILE* file = fopen(path.c_str(),"wb");
+    if(file)
+    {
+        fwrite(bytes.data(),1,bytes.size(),file);
+        fclose(file);
+    }
+}
+
+template<typename T>
+static T Load(const std::vector<unsigned char>& bytes, uint64_t offset)
+{
+    T value;
+    memcpy(&value,bytes.data()+offset,sizeof(T));
+    return value;
+}
+
+template<typename T>
+static void Store(std::vector<unsigned char>& bytes, uint64_t offset, const T& value)
+{
+    memcpy(bytes.data()+offset,&value,sizeof(T));
+}
+
+static uint64_t FrameOffset(const std::vector<unsigned char>& bytes, int frame)
+{
+    uint64_t frameTable = Load<CaptureHeader>(bytes,0).frameTable;
+    return Load<uint64_t>(bytes,frameTable+2*sizeof(uint32_t)+frame*sizeof(uint64_t));
+}
+
+static uint64_t ListOffset(const std::vector<unsigned char>& bytes, int frame, int list)
+{
+    return Load<uint64_t>(bytes,FrameOffset(bytes,frame)+sizeof(CaptureFrameHeader)+list*sizeof(uint64_t));
+}
+
+//text drawn with the font atlas
+static void BuildTextList(ImDrawList& drawList)
+{
+    drawList._ResetForNewFrame();
+    drawList.PushClipRect(ImVec2(0,0),ImVec2(320,240));
+    drawList.PushTextureID(FONT_TEXTURE);
+    drawList.AddRectFilled(ImVec2(10,10),ImVec2(50,30),IM_COL32(255,0,0,255));
+    drawList.AddRectFilled(ImVec2(60,10),ImVec2(90,30),IM_COL32(0,255,0,255));
+    drawList._PopUnusedDrawCmd();
+}
+
+//an image, a window cache quad and the application's own callback between font draws
+static void BuildImageList(ImDrawList& drawList, bool secondImage)
+{
+    drawList._ResetForNewFrame();
+    drawList.PushClipRect(ImVec2(20,20),ImVec2(200,200));
+    drawList.PushTextureID(FONT_TEXTURE);
+    drawList.PushTextureID(IMAGE_TEXTURE);
+    drawList.AddRectFilled(ImVec2(20,20),ImVec2(100,100),IM_COL32_WHITE);
+    drawList.PopTextureID();
+    drawList.AddCallback(ImGui_Slag_UseCompositePipeline,nullptr);
+    drawList.AddRectFilled(ImVec2(100,20),ImVec2(180,100),IM_COL32_WHITE);
+    drawList.AddCallback(ImDrawCallback_ResetRenderState,nullptr);
+    drawList.AddCallback(UserCallback,nullptr);
+    drawList.AddRectFilled(ImVec2(20,120),ImVec2(60,140),IM_COL32(0,0,255,255));
+    if(secondImage)
+    {
+        drawList.PushTextureID(OTHER_IMAGE_TEXTURE);
+        drawList.AddRectFilled(ImVec2(120,120),ImVec2(180,180),IM_COL32_WHITE);
+        drawList.PopTextureID();
+    }
+    drawList._PopUnusedDrawCmd();
+}
+
+static void SetLists(ImDrawData& drawData, ImDrawList& text, ImDrawList& image)
+{
+    drawData.Clear();
+    drawData.Valid = true;
+    drawData.CmdLists.push_back(&text);
+    drawData.CmdLists.push_back(&image);
+    drawData.CmdListsCount = 2;
+    drawData.DisplayPos = ImVec2(10,20);
+    drawData.DisplaySize = ImVec2(640,480);
+    drawData.FramebufferScale = ImVec2(2,2);
+}
+
+//texture the replay is expected to draw in place of a captured one
+struct TextureMap
+{
+    ImTextureID font;
+    ImTextureID image;
+    ImTextureID otherImage;
+    ImTextureID operator()(ImTextureID captured) const
+    {
+        return captured == IMAGE_TEXTURE ? image : captured == OTHER_IMAGE_TEXTURE ? otherImage : font;
+    }
+};
+
+//the replayed list matches the captured one, less the callbacks that can't be replayed
+static bool SameList(const ImDrawList* captured, const ImDrawList* replayed, const TextureMap& textures, bool compositeReplayed)
+{
+    if(captured->VtxBuffer.Size != replayed->VtxBuffer.Size || captured->IdxBuffer.Size != replayed->IdxBuffer.Size || captured->Flags != replayed->Flags ||
+       memcmp(captured->VtxBuffer.Data,replayed->VtxBuffer.Data,captured->VtxBuffer.size_in_bytes()) != 0 ||
+       memcmp(captured->IdxBuffer.Data,replayed->IdxBuffer.Data,captured->IdxBuffer.size_in_bytes()) != 0)
+    {
+        return false;
+    }
+    int next = 0;
+    for(const ImDrawCmd& cmd: captured->CmdBuffer)
+    {
+        if(cmd.UserCallback == UserCallback || (cmd.UserCallback == ImGui_Slag_UseCompositePipeline && !compositeReplayed))
+        {
+            continue;
+        }
+        if(next >= replayed->CmdBuffer.Size)
+        {
+            return false;
+        }
+        const ImDrawCmd& replayedCmd = replayed->CmdBuffer[next++];
+        if(memcmp(&cmd.ClipRect,&replayedCmd.ClipRect,sizeof(cmd.ClipRect)) != 0 || cmd.VtxOffset != replayedCmd.VtxOffset || cmd.IdxOffset != replayedCmd.IdxOffset ||
+           cmd.ElemCount != replayedCmd.ElemCount || cmd.UserCallback != replayedCmd.UserCallback || replayedCmd.GetTexID() != textures(cmd.GetTexID()))
+        {
+            return false;
+        }
+    }
+    return next == replayed->CmdBuffer.Size;
+}
+
+static bool SameFrame(const ImDrawData* captured, const ImDrawData* replayed, const TextureMap& textures, bool compositeReplayed)
+{
+    if(replayed == nullptr || captured->CmdListsCount != replayed->CmdListsCount ||
+       captured->DisplayPos.x != replayed->DisplayPos.x || captured->DisplayPos.y != replayed->DisplayPos.y ||
+       captured->DisplaySize.x != replayed->DisplaySize.x || captured->DisplaySize.y != replayed->DisplaySize.y ||
+       captured->FramebufferScale.x != replayed->FramebufferScale.x || captured->FramebufferScale.y != replayed->FramebufferScale.y)
+    {
+        return false;
+    }
+    for(int i=0; i<captured->CmdListsCount; i++)
+    {
+        if(!SameList(captured->CmdLists[i],replayed->CmdLists[i],textures,compositeReplayed))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//whether the first frame of a damaged copy of a capture is refused, either by OpenReplay or ReplayFrame
+static bool Refused(const std::string& path, const std::vector<unsigned char>& bytes)
+{
+    WriteFile(path,bytes);
+    ImGui_ImplSlag_Replay* replay = ImGui_ImplSlag_OpenReplay(path.c_str());
+    if(replay == nullptr)
+    {
+        return true;
+    }
+    bool refused = ImGui_ImplSlag_GetReplayFrameCount(replay) < 1 || ImGui_ImplSlag_ReplayFrame(replay,0) == nullptr;
+    ImGui_ImplSlag_CloseReplay(replay);
+    return refused;
+}
+
+int main()
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.Fonts->SetTexID(FONT_TEXTURE);
+    //replay only reads the window cache pipeline to decide whether composite quads are kept, any address will do
+    ImGui_ImplSlag_Data data;
+    data.compositeShaderPipeline = reinterpret_cast<slag::ShaderPipeline*>(0x10);
+    io.BackendRendererUserData = &data;
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string singlePath = (directory/"imgui_impl_slag_capture_single.imdc").string();
+    std::string sequencePath = (directory/"imgui_impl_slag_capture_sequence.imdc").string();
+    std::string damagedPath = (directory/"imgui_impl_slag_capture_damaged.imdc").string();
+
+    ImDrawList text(ImGui::GetDrawListSharedData());
+    ImDrawList image(ImGui::GetDrawListSharedData());
+    ImDrawList changedImage(ImGui::GetDrawListSharedData());
+    BuildTextList(text);
+    BuildImageList(image,false);
+    BuildImageList(changedImage,true);
+    ImDrawData first;
+    SetLists(first,text,image);
+    ImDrawData second;
+    SetLists(second,text,changedImage);
+
+    //a single frame round trips, with the application's callback dropped and counted
+    ImGui_ImplSlag_Capture* capture = ImGui_ImplSlag_BeginCapture(singlePath.c_str());
+    CHECK(capture != nullptr);
+    int dropped = -1;
+    CHECK(ImGui_ImplSlag_CaptureFrame(capture,&first,&dropped));
+    CHECK(dropped == 1);
+    CHECK(ImGui_ImplSlag_EndCapture(capture));
+    ImGui_ImplSlag_Replay* replay = ImGui_ImplSlag_OpenReplay(singlePath.c_str());
+    CHECK(replay != nullptr);
+    if(replay)
+    {
+        CHECK(ImGui_ImplSlag_GetReplayFrameCount(replay) == 1);
+        ImGui_ImplSlag_SetReplayTexture(replay,1,IMAGE_TEXTURE);
+        ImDrawData* replayed = ImGui_ImplSlag_ReplayFrame(replay,0);
+        CHECK(SameFrame(&first,replayed,TextureMap{FONT_TEXTURE,IMAGE_TEXTURE,FONT_TEXTURE},true));
+        CHECK(replayed && replayed->OwnerViewport == ImGui::GetMainViewport());
+        CHECK(replayed && replayed->TotalVtxCount == text.VtxBuffer.Size + image.VtxBuffer.Size);
+        ImGui_ImplSlag_CloseReplay(replay);
+    }
+
+    //lists that didn't change since the frame before are written once, and every frame still replays in full
+    capture = ImGui_ImplSlag_BeginCapture(sequencePath.c_str());
+    CHECK(capture != nullptr);
+    CHECK(ImGui_ImplSlag_CaptureFrame(capture,&first));
+    CHECK(ImGui_ImplSlag_CaptureFrame(capture,&second));
+    CHECK(ImGui_ImplSlag_CaptureFrame(capture,&second));
+    CHECK(ImGui_ImplSlag_EndCapture(capture));
+    std::vector<unsigned char> single = ReadFile(singlePath);
+    std::vector<unsigned char> sequence = ReadFile(sequencePath);
+    CHECK(ListOffset(sequence,1,0) == ListOffset(sequence,0,0));
+    CHECK(ListOffset(sequence,1,1) != ListOffset(sequence,0,1));
+    CHECK(ListOffset(sequence,2,0) == ListOffset(sequence,0,0));
+    CHECK(ListOffset(sequence,2,1) == ListOffset(sequence,1,1));
+    //the only list data past the first frame is the changed image list
+    size_t changedListBytes = Padded(sizeof(CaptureList)) + Padded(changedImage.VtxBuffer.size_in_bytes()) + Padded(changedImage.IdxBuffer.size_in_bytes()) + Padded((changedImage.CmdBuffer.Size-1)*sizeof(CaptureCommand));
+    size_t frameBytes = sizeof(CaptureFrameHeader) + 2*sizeof(uint64_t);
+    CHECK(sequence.size() == single.size() + changedListBytes + 2*(frameBytes + sizeof(uint64_t)));
+
+    //handles are numbered in order of first use, the font atlas is whatever is current when replaying and handles without a texture fall back to it
+    replay = ImGui_ImplSlag_OpenReplay(sequencePath.c_str());
+    CHECK(replay != nullptr);
+    if(replay)
+    {
+        CHECK(ImGui_ImplSlag_GetReplayFrameCount(replay) == 3);
+        const ImTextureID replayFont = (ImTextureID)0x1000;
+        const ImTextureID replayImage = (ImTextureID)0x2000;
+        const ImTextureID replayOtherImage = (ImTextureID)0x3000;
+        io.Fonts->SetTexID(replayFont);
+        ImGui_ImplSlag_SetReplayTexture(replay,1,replayImage);
+        CHECK(SameFrame(&first,ImGui_ImplSlag_ReplayFrame(replay,0),TextureMap{replayFont,replayImage,replayFont},true));
+        CHECK(SameFrame(&second,ImGui_ImplSlag_ReplayFrame(replay,1),TextureMap{replayFont,replayImage,replayFont},true));
+        ImGui_ImplSlag_SetReplayTexture(replay,2,replayOtherImage);
+        CHECK(SameFrame(&second,ImGui_ImplSlag_ReplayFrame(replay,2),TextureMap{replayFont,replayImage,replayOtherImage},true));
+        //without the window cache pipeline its quads are drawn as regular draws
+        data.compositeShaderPipeline = nullptr;
+        CHECK(SameFrame(&first,ImGui_ImplSlag_ReplayFrame(replay,0),TextureMap{replayFont,replayImage,replayFont},false));
+        ImGui_ImplSlag_CloseReplay(replay);
+        io.Fonts->SetTexID(FONT_TEXTURE);
+    }
+
+    //the undamaged copy replays, so each refusal below is down to its damage
+    CHECK(!Refused(damagedPath,single));
+    CHECK(ImGui_ImplSlag_OpenReplay((directory/"imgui_impl_slag_capture_missing.imdc").string().c_str()) == nullptr);
+
+    //files that aren't complete captures of this build aren't opened
+    std::vector<unsigned char> damaged = single;
+    Store<uint64_t>(damaged,offsetof(CaptureHeader,frameTable),0);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,offsetof(CaptureHeader,magic),0);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,offsetof(CaptureHeader,version),Load<uint32_t>(single,offsetof(CaptureHeader,version))+1);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,offsetof(CaptureHeader,vertexSize),sizeof(ImDrawVert)+4);
+    CHECK(Refused(damagedPath,damaged));
+    for(size_t size: {(size_t)0,sizeof(CaptureHeader)-1,sizeof(CaptureHeader),single.size()/2,single.size()-1})
+    {
+        damaged.assign(single.begin(),single.begin()+size);
+        CHECK(Refused(damagedPath,damaged));
+    }
+    damaged = single;
+    Store<uint32_t>(damaged,Load<CaptureHeader>(single,0).frameTable,1000);
+    CHECK(Refused(damagedPath,damaged));
+
+    //frames and lists pointing outside the file
+    damaged = single;
+    Store<uint64_t>(damaged,Load<CaptureHeader>(single,0).frameTable+2*sizeof(uint32_t),single.size());
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,FrameOffset(single,0)+offsetof(CaptureFrameHeader,listCount),1000);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint64_t>(damaged,FrameOffset(single,0)+sizeof(CaptureFrameHeader),single.size()-4);
+    CHECK(Refused(damagedPath,damaged));
+
+    //lists whose counts run past the file, and commands that would read outside the list's buffers
+    uint64_t list = ListOffset(single,0,0);
+    uint64_t indices = list + Padded(sizeof(CaptureList)) + Padded(text.VtxBuffer.size_in_bytes());
+    uint64_t commands = indices + Padded(text.IdxBuffer.size_in_bytes());
+    damaged = single;
+    Store<uint32_t>(damaged,list+offsetof(CaptureList,vertexCount),0x10000000);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,list+offsetof(CaptureList,commandCount),1000);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,commands+offsetof(CaptureCommand,kind),1000);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,commands+offsetof(CaptureCommand,elementCount),text.IdxBuffer.Size+3);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<uint32_t>(damaged,commands+offsetof(CaptureCommand,vertexOffset),text.VtxBuffer.Size);
+    CHECK(Refused(damagedPath,damaged));
+    damaged = single;
+    Store<ImDrawIdx>(damaged,indices,(ImDrawIdx)text.VtxBuffer.Size);
+    CHECK(Refused(damagedPath,damaged));
+
+    std::filesystem::remove(singlePath);
+    std::filesystem::remove(sequencePath);
+    std::filesystem::remove(damagedPath);
+    io.BackendRendererUserData = nullptr;
+    ImGui::DestroyContext();
+
+    if(failures == 0)
+    {
+        printf("capture replay test passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
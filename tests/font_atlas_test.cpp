@@ -0,0 +1,103 @@
+//checks that rasterizing the font atlas on the backend's job system gives the same atlas as building it on one thread
+#include "../imgui_impl_slag.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+void ImGui_Slag_FontBuilderParallelFor(int jobCount, void (*job)(int jobIndex, void* jobData), void* jobData, void* userData);
+
+static int failures = 0;
+
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: %s failed\n",__FILE__,__LINE__,#cond); failures++; } } while(0)
+
+//a job system that runs the jobs on a few threads of its own, counting how many it was given
+struct TestJobSystem
+{
+    uint32_t threadCount = 8;
+    uint32_t jobsRun = 0;
+};
+
+static void ThreadsParallelFor(uint32_t jobCount, void (*job)(uint32_t jobIndex, void* jobData), void* jobData, void* userData)
+{
+    auto jobSystem = static_cast<TestJobSystem*>(userData);
+    std::atomic<uint32_t> next{0};
+    std::vector<std::thread> threads;
+    for(uint32_t i=0; i<jobSystem->threadCount; i++)
+    {
+        threads.emplace_back([&]()
+        {
+            for(uint32_t jobIndex = next++; jobIndex < jobCount; jobIndex = next++)
+            {
+                job(jobIndex,jobData);
+            }
+        });
+    }
+    for(auto& thread: threads)
+    {
+        thread.join();
+    }
+    jobSystem->jobsRun += jobCount;
+}
+
+//several sizes, oversampled and one with a multiplier, so each source font is split over several jobs
+static void AddFonts(ImFontAtlas& atlas)
+{
+    for(float size: {13.0f,20.0f,32.0f})
+    {
+        ImFontConfig config;
+        config.SizePixels = size;
+        config.OversampleH = 3;
+        config.OversampleV = 2;
+        config.RasterizerMultiply = size == 20.0f ? 1.5f : 1.0f;
+        atlas.AddFontDefault(&config);
+    }
+}
+
+int main()
+{
+    ImFontAtlas serial;
+    AddFonts(serial);
+    unsigned char* serialPixels = nullptr;
+    int serialWidth = 0, serialHeight = 0;
+    serial.GetTexDataAsAlpha8(&serialPixels,&serialWidth,&serialHeight);
+
+    ImGui_ImplSlag_Data data;
+    TestJobSystem jobSystem;
+    data.parallelFor = ThreadsParallelFor;
+    data.parallelForUserData = &jobSystem;
+    ImFontAtlas parallel;
+    AddFonts(parallel);
+    parallel.BuilderParallelFor = ImGui_Slag_FontBuilderParallelFor;
+    parallel.BuilderParallelForUserData = &data;
+    unsigned char* parallelPixels = nullptr;
+    int parallelWidth = 0, parallelHeight = 0;
+    parallel.GetTexDataAsAlpha8(&parallelPixels,&parallelWidth,&parallelHeight);
+
+    //more jobs than source fonts, or nothing ran in parallel
+    CHECK(jobSystem.jobsRun > (uint32_t)parallel.ConfigData.Size);
+    CHECK(serialPixels != nullptr && parallelPixels != nullptr);
+    CHECK(serialWidth == parallelWidth && serialHeight == parallelHeight);
+    if(serialPixels && parallelPixels && serialWidth == parallelWidth && serialHeight == parallelHeight)
+    {
+        CHECK(memcmp(serialPixels,parallelPixels,(size_t)serialWidth*serialHeight) == 0);
+    }
+    CHECK(serial.Fonts.Size == parallel.Fonts.Size);
+    for(int i=0; i<serial.Fonts.Size && i<parallel.Fonts.Size; i++)
+    {
+        const ImFont* serialFont = serial.Fonts[i];
+        const ImFont* parallelFont = parallel.Fonts[i];
+        CHECK(serialFont->Glyphs.Size == parallelFont->Glyphs.Size);
+        if(serialFont->Glyphs.Size == parallelFont->Glyphs.Size)
+        {
+            CHECK(memcmp(serialFont->Glyphs.Data,parallelFont->Glyphs.Data,serialFont->Glyphs.size_in_bytes()) == 0);
+        }
+    }
+
+    if(failures == 0)
+    {
+        printf("font atlas test passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+//checks the pipeline the renderer draws with as single channel textures, resets and the backend's own callbacks are mixed
+#include "../imgui_impl_slag.h"
+#include <cstdio>
+
+void ImGui_Slag_ApplyUserCallback(ImGui_ImplSlag_Data* rendererData, slag::ShaderPipeline* shader, ImGui_ImplSlag_BoundState& boundState, ImDrawCallback callback);
+bool ImGui_Slag_PrepareDraw(ImGui_ImplSlag_Data* rendererData, slag::ShaderPipeline* shader, ImGui_ImplSlag_BoundState& boundState, ImTextureID textureId, slag::ShaderPipeline*& switchTo, slag::DescriptorPool*& bindPool);
+void ImGui_Slag_UseCompositePipeline(const ImDrawList* drawList, const ImDrawCmd* cmd);
+void ImGui_Slag_UseSdfPipeline(const ImDrawList* drawList, const ImDrawCmd* cmd);
+
+static int failures = 0;
+
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: %s failed\n",__FILE__,__LINE__,#cond); failures++; } } while(0)
+
+//pipelines are only compared, never used, so any distinct address will do
+static slag::ShaderPipeline* FakePipeline(uintptr_t value)
+{
+    return reinterpret_cast<slag::ShaderPipeline*>(value);
+}
+
+//what the renderer does for a draw command, returns the pipeline the draw ends up using
+static slag::ShaderPipeline* Draw(ImGui_ImplSlag_Data& data, slag::ShaderPipeline* shader, ImGui_ImplSlag_BoundState& boundState, ImTextureID textureId)
+{
+    slag::ShaderPipeline* switchTo = nullptr;
+    slag::DescriptorPool* bindPool = nullptr;
+    ImGui_Slag_PrepareDraw(&data,shader,boundState,textureId,switchTo,bindPool);
+    return boundState.pipeline;
+}
+
+static void Callback(ImGui_ImplSlag_Data& data, slag::ShaderPipeline* shader, ImGui_ImplSlag_BoundState& boundState, ImDrawCallback callback)
+{
+    if(callback == ImDrawCallback_ResetRenderState)
+    {
+        boundState.reset(shader);
+    }
+    else
+    {
+        ImGui_Slag_ApplyUserCallback(&data,shader,boundState,callback);
+    }
+}
+
+static void UserCallback(const ImDrawList*, const ImDrawCmd*)
+{
+}
+
+int main()
+{
+    ImGui_ImplSlag_Data data;
+    slag::ShaderPipeline* shader = FakePipeline(0x10);
+    data.shaderPipeline = shader;
+    data.alphaShaderPipeline = FakePipeline(0x20);
+    data.sdfShaderPipeline = FakePipeline(0x30);
+    data.compositeShaderPipeline = FakePipeline(0x40);
+
+    //the r8 font atlas and an rgba window cache, ids stand in for their bundles
+    ImGui_ImplSlag_TextureEntry font;
+    font.channels = ImGui_ImplSlag_TextureChannels_Alpha;
+    font.id = 0x100;
+    ImGui_ImplSlag_TextureEntry cache;
+    cache.id = 0x200;
+    data.textureIds[font.id] = &font;
+    data.textureIds[cache.id] = &cache;
+    data.fontsTextureId = font.id;
+
+    ImGui_ImplSlag_BoundState boundState;
+    boundState.reset(shader);
+    CHECK(Draw(data,shader,boundState,font.id) == data.alphaShaderPipeline);
+
+    //the same r8 texture after a reset is bound again with the alpha pipeline
+    Callback(data,shader,boundState,ImDrawCallback_ResetRenderState);
+    CHECK(Draw(data,shader,boundState,font.id) == data.alphaShaderPipeline);
+
+    //a composite quad draws its rgba cache with the composite pipeline, and r8 text after it switches back once reset
+    Callback(data,shader,boundState,ImGui_Slag_UseCompositePipeline);
+    CHECK(!boundState.pipelinePinned);
+    CHECK(Draw(data,shader,boundState,cache.id) == data.compositeShaderPipeline);
+    Callback(data,shader,boundState,ImDrawCallback_ResetRenderState);
+    CHECK(Draw(data,shader,boundState,font.id) == data.alphaShaderPipeline);
+    CHECK(Draw(data,shader,boundState,cache.id) == shader);
+    CHECK(Draw(data,shader,boundState,font.id) == data.alphaShaderPipeline);
+
+    //sdf text keeps the sdf pipeline for the atlas, and text after the pop is alpha again
+    Callback(data,shader,boundState,ImGui_Slag_UseSdfPipeline);
+    CHECK(!boundState.pipelinePinned);
+    CHECK(Draw(data,shader,boundState,font.id) == data.sdfShaderPipeline);
+    Callback(data,shader,boundState,ImDrawCallback_ResetRenderState);
+    CHECK(Draw(data,shader,boundState,cache.id) == shader);
+    CHECK(Draw(data,shader,boundState,font.id) == data.alphaShaderPipeline);
+
+    //user callbacks pin whatever they bound until the next reset
+    Callback(data,shader,boundState,UserCallback);
+    CHECK(boundState.pipelinePinned);
+    CHECK(Draw(data,shader,boundState,font.id) == shader);
+    Callback(data,shader,boundState,ImDrawCallback_ResetRenderState);
+    CHECK(!boundState.pipelinePinned);
+    CHECK(Draw(data,shader,boundState,font.id) == data.alphaShaderPipeline);
+
+    if(failures == 0)
+    {
+        printf("render state test passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
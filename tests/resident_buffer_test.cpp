@@ -0,0 +1,100 @@
+//checks that ranges freed from a resident buffer only come back once their frame retires, and merge with free neighbours on either side
+#include "../imgui_impl_slag.h"
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+extern slag::Buffer* (*IMGUI_IMPL_SLAG_NEW_BUFFER)(size_t size, slag::Buffer::Usage usage);
+extern void (*IMGUI_IMPL_SLAG_DELETE_BUFFER)(slag::Buffer* buffer);
+
+static int failures = 0;
+
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: %s failed\n",__FILE__,__LINE__,#cond); failures++; } } while(0)
+
+//the buffer is never written through, only its size and lifetime matter
+static size_t createdSize = 0;
+static int liveBuffers = 0;
+
+static slag::Buffer* FakeNewBuffer(size_t size, slag::Buffer::Usage)
+{
+    createdSize = size;
+    liveBuffers++;
+    return reinterpret_cast<slag::Buffer*>(0x100);
+}
+
+static void FakeDeleteBuffer(slag::Buffer* buffer)
+{
+    if(buffer)
+    {
+        liveBuffers--;
+    }
+}
+
+static bool FreeRangesAre(const ImGui_ImplSlag_ResidentBuffer& resident, std::vector<std::pair<uint32_t,uint32_t>> ranges)
+{
+    return resident.freeRanges == ranges;
+}
+
+int main()
+{
+    IMGUI_IMPL_SLAG_NEW_BUFFER = FakeNewBuffer;
+    IMGUI_IMPL_SLAG_DELETE_BUFFER = FakeDeleteBuffer;
+    {
+        ImGui_ImplSlag_ResidentBuffer resident(100,sizeof(ImDrawVert),slag::Buffer::VERTEX_BUFFER);
+        CHECK(createdSize == 100*sizeof(ImDrawVert) && liveBuffers == 1);
+        CHECK(FreeRangesAre(resident,{{0,100}}));
+
+        //ranges are handed out first fit, and a range used up entirely leaves the free list
+        uint32_t first = 0;
+        for(uint32_t expected: {0u,10u,20u,30u})
+        {
+            CHECK(resident.allocate(10,first) && first == expected);
+        }
+        CHECK(resident.allocate(60,first) && first == 40);
+        CHECK(resident.freeRanges.empty());
+        CHECK(!resident.allocate(1,first));
+
+        //freed ranges wait for the frame that last drew them to retire
+        resident.free(0,10,3);
+        resident.free(40,60,5);
+        resident.collect(2);
+        CHECK(resident.freeRanges.empty());
+        resident.collect(3);
+        CHECK(FreeRangesAre(resident,{{0,10}}));
+        CHECK(resident.retiringRanges.size() == 1);
+
+        //a range next to a free one before it extends it
+        resident.free(10,10,5);
+        resident.collect(5);
+        CHECK(FreeRangesAre(resident,{{0,20},{40,60}}));
+        CHECK(resident.retiringRanges.empty());
+
+        //a range next to a free one after it extends that one backwards
+        resident.free(30,10,6);
+        resident.collect(6);
+        CHECK(FreeRangesAre(resident,{{0,20},{30,70}}));
+        CHECK(!resident.allocate(80,first));
+
+        //a range filling the gap between two free ones joins all three, so the whole buffer can be allocated again
+        resident.free(20,10,7);
+        resident.collect(7);
+        CHECK(FreeRangesAre(resident,{{0,100}}));
+        CHECK(resident.allocate(100,first) && first == 0);
+
+        //ranges retired out of order still end up sorted and merged
+        resident.free(50,50,9);
+        resident.free(0,20,8);
+        resident.free(20,30,10);
+        resident.collect(9);
+        CHECK(FreeRangesAre(resident,{{0,20},{50,50}}));
+        resident.collect(10);
+        CHECK(FreeRangesAre(resident,{{0,100}}));
+    }
+    CHECK(liveBuffers == 0);
+
+    if(failures == 0)
+    {
+        printf("resident buffer test passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+//checks where the upload ring hands out memory as frames cycle, and that buffers it outgrows live until the frames using them are done
+#include "../imgui_impl_slag.h"
+#include <cstdio>
+#include <vector>
+
+extern slag::Buffer* (*IMGUI_IMPL_SLAG_NEW_BUFFER)(size_t size, slag::Buffer::Usage usage);
+extern void (*IMGUI_IMPL_SLAG_DELETE_BUFFER)(slag::Buffer* buffer);
+
+static int failures = 0;
+
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: %s failed\n",__FILE__,__LINE__,#cond); failures++; } } while(0)
+
+//buffers are never written through, so they're only numbered addresses whose creation and deletion is tracked
+static std::vector<size_t> createdSizes;
+static std::vector<slag::Buffer*> liveBuffers;
+
+static slag::Buffer* FakeNewBuffer(size_t size, slag::Buffer::Usage)
+{
+    createdSizes.push_back(size);
+    auto buffer = reinterpret_cast<slag::Buffer*>((uintptr_t)createdSizes.size()*0x100);
+    liveBuffers.push_back(buffer);
+    return buffer;
+}
+
+static void FakeDeleteBuffer(slag::Buffer* buffer)
+{
+    for(size_t i=0; i<liveBuffers.size(); i++)
+    {
+        if(liveBuffers[i] == buffer)
+        {
+            liveBuffers.erase(liveBuffers.begin()+i);
+            return;
+        }
+    }
+    //deleting something that isn't live is a double free
+    CHECK(buffer == nullptr);
+}
+
+static bool Live(slag::Buffer* buffer)
+{
+    for(auto live: liveBuffers)
+    {
+        if(live == buffer)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main()
+{
+    IMGUI_IMPL_SLAG_NEW_BUFFER = FakeNewBuffer;
+    IMGUI_IMPL_SLAG_DELETE_BUFFER = FakeDeleteBuffer;
+    {
+        //sizes are rounded up to the ring's granularity
+        ImGui_ImplSlag_RingBuffer ring(1000,slag::Buffer::VERTEX_BUFFER,2);
+        CHECK(ring.capacity == 1024);
+        CHECK(createdSizes.size() == 1 && createdSizes[0] == 1024);
+        slag::Buffer* first = ring.buffer;
+
+        //allocations are aligned and packed one after the other
+        ring.beginFrame(0);
+        CHECK(ring.allocate(300,16) == 0);
+        ring.beginFrame(1);
+        CHECK(ring.allocate(10,16) == 304);
+        CHECK(ring.allocate(500,256) == 512);
+
+        //once slot 0 comes around its frame is done, so an allocation that doesn't fit before the end wraps over it
+        ring.beginFrame(0);
+        CHECK(ring.allocate(200,4) == 0);
+        CHECK(ring.buffer == first && ring.reallocations == 0);
+        CHECK(ring.highWaterMark == 1012);
+
+        //slot 1's allocations are still in flight, so the next one that would overwrite them grows the ring into a new buffer
+        CHECK(ring.allocate(400,16) == 0);
+        CHECK(ring.buffer != first && ring.reallocations == 1);
+        CHECK(ring.capacity == 2048);
+        CHECK(createdSizes.size() == 2 && createdSizes[1] == 2048);
+        slag::Buffer* second = ring.buffer;
+        CHECK(ring.allocate(100,16) == 400);
+
+        //the old buffer stays alive until every slot has started a frame since it was replaced
+        CHECK(Live(first));
+        ring.beginFrame(1);
+        CHECK(Live(first));
+        CHECK(ring.allocate(100,16) == 512);
+        ring.beginFrame(0);
+        CHECK(!Live(first));
+        CHECK(ring.retiredBuffers.empty());
+        CHECK(liveBuffers.size() == 1 && liveBuffers[0] == second);
+
+        //a single allocation bigger than the ring grows it to at least twice its size
+        ring.beginFrame(1);
+        CHECK(ring.allocate(5000,16) == 0);
+        CHECK(ring.capacity >= 10000 && ring.reallocations == 2);
+        CHECK(Live(second) && liveBuffers.size() == 2);
+    }
+    //the destructor frees the current buffer and any still retiring
+    CHECK(liveBuffers.empty());
+
+    {
+        //a ring made empty only creates its buffer on the first allocation
+        ImGui_ImplSlag_RingBuffer ring(0,slag::Buffer::INDIRECT_BUFFER,3);
+        CHECK(ring.buffer == nullptr && liveBuffers.empty());
+        ring.beginFrame(0);
+        CHECK(ring.allocate(64,16) == 0);
+        CHECK(ring.buffer != nullptr && ring.capacity == 256 && ring.reallocations == 0);
+    }
+    CHECK(liveBuffers.empty());
+
+    if(failures == 0)
+    {
+        printf("ring buffer test passed\n");
+    }
+    return failures == 0 ? 0 : 1;
+}